@@ -37,6 +37,7 @@
 #include "classlist.h"
 #include "config.h"
 #include "filename.h"
+#include "symbolmap.h"
 
 class XRefDummyCodeGenerator : public CodeOutputInterface
 {
@@ -145,24 +146,15 @@ static void listSymbol(Definition *d)
 
 static void listSymbols()
 {
-  QDictIterator<DefinitionIntf> sli(*Doxygen::symbolMap);
-  DefinitionIntf *di;
-  for (sli.toFirst();(di=sli.current());++sli)
+  SymbolMap::Iterator sli(*Doxygen::symbolMap);
+  const SymbolList *sl;
+  for (;(sl=sli.current());++sli)
   {
-    if (di->definitionType()==DefinitionIntf::TypeSymbolList) // list of symbols
-      // with same name
+    // for each symbol with the same name
+    uint i;
+    for (i=0;i<sl->count();i++)
     {
-      DefinitionListIterator dli(*(DefinitionList*)di);
-      Definition *d;
-      // for each symbol
-      for (dli.toFirst();(d=dli.current());++dli)
-      {
-        listSymbol(d);
-      }
-    }
-    else // single symbol
-    {
-      listSymbol((Definition*)di);
+      listSymbol(sl->at(i));
     }
   }
 }
@@ -220,22 +212,14 @@ static void lookupSymbols(const QCString &sym)
 {
   if (!sym.isEmpty())
   {
-    DefinitionIntf *di = Doxygen::symbolMap->find(sym);
-    if (di)
+    const SymbolList *sl = Doxygen::symbolMap->find(sym);
+    if (sl)
     {
-      if (di->definitionType()==DefinitionIntf::TypeSymbolList)
-      {
-        DefinitionListIterator dli(*(DefinitionList*)di);
-        Definition *d;
-        // for each symbol with the given name
-        for (dli.toFirst();(d=dli.current());++dli)
-        {
-          lookupSymbol(d);
-        }
-      }
-      else
+      // for each symbol with the given name
+      uint i;
+      for (i=0;i<sl->count();i++)
       {
-        lookupSymbol((Definition*)di);
+        lookupSymbol(sl->at(i));
       }
     }
     else
@@ -1,7 +1,55 @@
 #include "arguments.h"
 #include "marshal.h"
+#include "objpool.h"
 #include <assert.h>
 
+static ObjPool g_argumentPool(sizeof(Argument));
+static ObjPool g_argumentListPool(sizeof(ArgumentList));
+
+void *Argument::operator new(size_t size)
+{
+  if (size==sizeof(Argument)) return g_argumentPool.alloc();
+  void *p = malloc(size);
+  if (p==0) throw std::bad_alloc();
+  return p;
+}
+
+void Argument::operator delete(void *p,size_t size)
+{
+  if (p==0) return;
+  if (size==sizeof(Argument)) g_argumentPool.free(p); else ::free(p);
+}
+
+uint64 Argument::numCreated()
+{
+  return g_argumentPool.numAllocated();
+}
+
+void *ArgumentList::operator new(size_t size)
+{
+  if (size==sizeof(ArgumentList)) return g_argumentListPool.alloc();
+  void *p = malloc(size);
+  if (p==0) throw std::bad_alloc();
+  return p;
+}
+
+void ArgumentList::operator delete(void *p,size_t size)
+{
+  if (p==0) return;
+  if (size==sizeof(ArgumentList)) g_argumentListPool.free(p); else ::free(p);
+}
+
+uint64 ArgumentList::numCreated()
+{
+  return g_argumentListPool.numAllocated();
+}
+
+void ArgumentList::trimPools()
+{
+  g_argumentListPool.trim();
+  g_argumentPool.trim();
+}
+
 /*! the argument list is documented if one of its
  *  arguments is documented 
  */
@@ -71,6 +71,12 @@ struct Argument
   QCString defval;   /*!< Argument's default value (may be empty) */
   QCString docs;     /*!< Argument's documentation (may be empty) */
   QCString typeConstraint;  /*!< Used for Java generics: \<T extends C\> */
+
+  /*! Arguments are allocated from a pool, like entries. */
+  void *operator new(size_t size);
+  void operator delete(void *p,size_t size);
+  /*! Returns the number of arguments created so far. */
+  static uint64 numCreated();
 };
 
 /*! \brief This class represents an function or template argument list. 
@@ -106,6 +112,16 @@ class ArgumentList : public QList<Argument>
 
     static ArgumentList *unmarshal(StorageIntf *s);
     static void marshal(StorageIntf *s,ArgumentList *argList);
+
+    /*! Argument lists are allocated from a pool, like entries. */
+    void *operator new(size_t size);
+    void operator delete(void *p,size_t size);
+    /*! Returns the number of argument lists created so far. */
+    static uint64 numCreated();
+    /*! Releases the memory of the pools that no longer hold argument
+     *  lists or arguments.
+     */
+    static void trimPools();
 };
 
 typedef QListIterator<Argument> ArgumentListIterator;
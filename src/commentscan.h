@@ -80,5 +80,11 @@ void openGroup(Entry *e,const char *file,int line);
 void closeGroup(Entry *,const char *file,int line,bool foundInline=FALSE);
 void initGroupInfo(Entry *e);
 
+/** Returns the number of formulas, citations, xref items and member groups
+ *  found by the comment block parser so far. These are stored in global
+ *  dictionaries using ids that depend on the order in which files are parsed.
+ */
+int countGlobalDocItems();
+
 
 #endif
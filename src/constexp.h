@@ -29,5 +29,6 @@ extern QCString g_strToken;
 extern CPPValue g_resultValue;
 extern QCString g_constExpFileName;
 extern int      g_constExpLineNr;
+extern bool     g_constExpError;
 
 #endif
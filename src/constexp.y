@@ -33,6 +33,7 @@
 
 int constexpYYerror(const char *s)
 {
+  g_constExpError = TRUE;
   warn(g_constExpFileName,g_constExpLineNr,
        "preprocessing issue while doing constant expression evaluation: %s",s);
   return 0;
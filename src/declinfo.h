@@ -30,4 +30,13 @@ extern void parseFuncDecl(const QCString &decl,
                           QCString &funcTempList,
                           QCString &exceptions
                          );
+
+/** Sets up the cache of parseFuncDecl(). */
+extern void initFuncDeclCache();
+
+/** Returns the number of declarations found in the cache of
+ *  parseFuncDecl() and the number that had to be parsed.
+ */
+extern void funcDeclCacheStats(uint &hits,uint &misses);
+
 #endif
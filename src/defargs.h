@@ -18,10 +18,21 @@
 #ifndef DEFARGS_H
 #define DEFARGS_H
 
+#include <qglobal.h>
+
 class ArgumentList;
 class QCString;
 
 extern void stringToArgumentList(const char *argsString,ArgumentList* argList,
                                  QCString *extraTypeChars=0);
 
+/** Sets up the cache of stringToArgumentList(). */
+extern void initArgumentListCache();
+
+/** Returns the number of argument strings found in the cache of
+ *  stringToArgumentList(), the number that had to be converted, and the
+ *  number of those that were converted without running the scanner.
+ */
+extern void argumentListCacheStats(uint &hits,uint &misses,uint &simple);
+
 #endif
@@ -17,9 +17,12 @@
 
 #include <ctype.h>
 #include <qregexp.h>
+#include <qcache.h>
+#include <qgstring.h>
 #include "md5.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include "config.h"
 #include "definition.h"
@@ -41,6 +44,8 @@
 #include "namespacedef.h"
 #include "filedef.h"
 #include "dirdef.h"
+#include "symbolmap.h"
+#include "stringpool.h"
 
 #define START_MARKER 0x4445465B // DEF[
 #define END_MARKER   0x4445465D // DEF]
@@ -112,7 +117,7 @@ DefinitionImpl::~DefinitionImpl()
 
 void DefinitionImpl::init(const char *df, const char *n)
 {
-  defFileName = df;
+  defFileName = StringPool::intern(df);
   int lastDot = defFileName.findRev('.');
   if (lastDot!=-1)
   {
@@ -213,41 +218,8 @@ void Definition::addToMap(const char *name,Definition *d)
   if (!symbolName.isEmpty()) 
   {
     //printf("******* adding symbol `%s' (%p)\n",symbolName.data(),d);
-    DefinitionIntf *di=Doxygen::symbolMap->find(symbolName);
-    //printf("  addToMap(%p): looking for symbol %s: %p\n",d,symbolName.data(),di);
-    if (di==0) // new Symbol
-    {
-      //printf("  new symbol!\n");
-      Doxygen::symbolMap->insert(symbolName,d);
-    }
-    else // existing symbol
-    {
-      //printf("  existing symbol: ");
-      if (di->definitionType()==DefinitionIntf::TypeSymbolList) // already multiple symbols
-      {
-        //printf("adding to exiting list\n");
-        DefinitionList *dl = (DefinitionList*)di;
-        dl->append(d);
-      }
-      else // going from one to two symbols
-      {
-        Doxygen::symbolMap->take(symbolName);
-        DefinitionList *dl = new DefinitionList;
-        //printf("replacing symbol by list %p with elements %p and %p\n",dl,di,d);
-        dl->append((Definition*)di);
-        dl->append(d);
-        Doxygen::symbolMap->insert(symbolName,dl);
-      }
-    }
-
-    // auto resize if needed
-    static int sizeIndex=9;
-    if (Doxygen::symbolMap->size()>SDict_primes[sizeIndex])
-    {
-      Doxygen::symbolMap->resize(SDict_primes[++sizeIndex]);
-    }
-
-    d->_setSymbolName(symbolName);
+    // use the copy of the name stored in the map
+    d->_setSymbolName(Doxygen::symbolMap->add(symbolName,d));
   }
 }
 
@@ -257,26 +229,7 @@ void Definition::removeFromMap(Definition *d)
   if (!symbolName.isEmpty()) 
   {
     //printf("******* removing symbol `%s' (%p)\n",symbolName.data(),d);
-    DefinitionIntf *di=Doxygen::symbolMap->find(symbolName);
-    if (di)
-    {
-      if (di!=d) // symbolName not unique
-      {
-        //printf("  removing from list: %p!\n",di);
-        DefinitionList *dl = (DefinitionList*)di;
-        bool b = dl->removeRef(d);
-        ASSERT(b==TRUE);
-        if (dl->isEmpty())
-        {
-          Doxygen::symbolMap->take(symbolName);
-        }
-      }
-      else // symbolName unique
-      {
-        //printf("  removing symbol %p\n",di);
-        Doxygen::symbolMap->take(symbolName);
-      }
-    }
+    Doxygen::symbolMap->remove(symbolName,d);
   }
 }
 
@@ -284,7 +237,7 @@ Definition::Definition(const char *df,int dl,int dc,
                        const char *name,const char *b,
                        const char *d,bool isSymbol)
 {
-  m_name = name;
+  m_name = StringPool::intern(name);
   m_defLine = dl;
   m_defColumn = dc;
   m_impl = new DefinitionImpl;
@@ -394,7 +347,7 @@ Definition::~Definition()
 void Definition::setName(const char *name)
 {
   if (name==0) return;
-  m_name = name;
+  m_name = StringPool::intern(name);
 }
 
 void Definition::setId(const char *id)
@@ -596,12 +549,12 @@ void Definition::_setDocumentation(const char *d,const char *docFile,int docLine
     }
     if (docLine!=-1) // store location if valid
     {
-      m_impl->details->file = docFile;
+      m_impl->details->file = StringPool::intern(docFile);
       m_impl->details->line = docLine;
     }
     else
     {
-      m_impl->details->file = docFile;
+      m_impl->details->file = StringPool::intern(docFile);
       m_impl->details->line = 1;
     }
   }
@@ -666,12 +619,12 @@ void Definition::_setBriefDescription(const char *b,const char *briefFile,int br
       m_impl->brief->doc=brief;
       if (briefLine!=-1)
       {
-        m_impl->brief->file = briefFile;
+        m_impl->brief->file = StringPool::intern(briefFile);
         m_impl->brief->line = briefLine;
       }
       else
       {
-        m_impl->brief->file = briefFile;
+        m_impl->brief->file = StringPool::intern(briefFile);
         m_impl->brief->line = 1;
       }
     }
@@ -697,7 +650,7 @@ void Definition::_setInbodyDocumentation(const char *doc,const char *inbodyFile,
   if (m_impl->inbodyDocs->doc.isEmpty()) // fresh inbody docs
   {
     m_impl->inbodyDocs->doc  = doc;
-    m_impl->inbodyDocs->file = inbodyFile;
+    m_impl->inbodyDocs->file = StringPool::intern(inbodyFile);
     m_impl->inbodyDocs->line = inbodyLine;
   }
   else // another inbody documentation fragment, append this to the end
@@ -712,6 +665,120 @@ void Definition::setInbodyDocumentation(const char *d,const char *inbodyFile,int
   _setInbodyDocumentation(d,inbodyFile,inbodyLine);
 }
 
+//----------------------------------------------------------------------
+
+/** Contents of a source file, as read by readCodeFragment(), together
+ *  with the positions at which its lines start.
+ */
+struct SourceFileContents
+{
+  QGString    text;
+  QArray<int> lineStarts;  // lineStarts[i] is the position of line i+1
+};
+
+/** Maximum number of bytes of source text kept by the fragment cache. */
+static const int g_maxSourceCacheSize = 64*1024*1024;
+
+static QCache<SourceFileContents> g_sourceFileCache(g_maxSourceCacheSize,1009);
+
+void initSourceFileCache()
+{
+  g_sourceFileCache.setAutoDelete(TRUE);
+}
+
+static SourceFileContents *readSourceFileContents(const char *fileName,bool usePipe,
+                                                  const QCString &filter)
+{
+  FILE *f=0;
+  if (!usePipe) // no filter given or wanted
+  {
+    f = portable_fopen(fileName,"r");
+  }
+  else // use filter
+  {
+    QCString cmd=filter+" \""+fileName+"\"";
+    Debug::print(Debug::ExtCmd,0,"Executing popen(`%s`)\n",qPrint(cmd));
+    f = portable_popen(cmd,"r");
+  }
+  if (f==0) return 0;
+
+  SourceFileContents *sfc = new SourceFileContents;
+  const int bufSize=4096;
+  char buf[bufSize];
+  int size;
+  while ((size=(int)fread(buf,1,bufSize,f))>0)
+  {
+    uint len = sfc->text.length();
+    if (len+size+1>sfc->text.size())
+    {
+      sfc->text.enlarge(QMAX(len+size+1,2*sfc->text.size()));
+    }
+    memcpy(sfc->text.data()+len,buf,size);
+    sfc->text.setLen(len+size);
+  }
+  if (usePipe)
+  {
+    portable_pclose(f);
+  }
+  else
+  {
+    fclose(f);
+  }
+
+  // index the start of each line
+  const char *p = sfc->text.data();
+  int len = sfc->text.length();
+  int numLines=1,i;
+  for (i=0;i<len;i++) if (p[i]=='\n') numLines++;
+  sfc->lineStarts.resize(numLines);
+  sfc->lineStarts[0]=0;
+  int l=1;
+  for (i=0;i<len;i++) if (p[i]=='\n') sfc->lineStarts[l++]=i+1;
+  return sfc;
+}
+
+/** Reads the cached contents of a source file the way a FILE stream would
+ *  be read, i.e. the end of file is only reported after trying to read
+ *  beyond it.
+ */
+class SourceFileReader
+{
+  public:
+    SourceFileReader(const QGString &text)
+      : m_data(text.data()), m_len(text.length()), m_pos(0), m_eof(FALSE) {}
+    void seek(int pos) { m_pos=pos; }
+    void seekToEnd()   { m_pos=m_len; m_eof=TRUE; }
+    bool eof() const   { return m_eof; }
+    int getc()
+    {
+      if (m_pos<m_len) return (uchar)m_data[m_pos++];
+      m_eof=TRUE;
+      return EOF;
+    }
+    /** Reads up to \a size-1 characters into \a buf, stopping after a
+     *  newline. Returns 0 if nothing could be read.
+     */
+    char *gets(char *buf,int size)
+    {
+      if (m_pos>=m_len) { m_eof=TRUE; return 0; }
+      int i=0;
+      while (i<size-1 && m_pos<m_len)
+      {
+        char c = m_data[m_pos++];
+        buf[i++]=c;
+        if (c=='\n') break;
+      }
+      if (m_pos>=m_len && i<size-1 && buf[i-1]!='\n') m_eof=TRUE;
+      buf[i]='\0';
+      return buf;
+    }
+  private:
+    const char *m_data;
+    int  m_len;
+    int  m_pos;
+    bool m_eof;
+};
+
 /*! Reads a fragment of code from file \a fileName starting at 
  * line \a startLine and ending at line \a endLine (inclusive). The fragment is
  * stored in \a result. If FALSE is returned the code fragment could not be
@@ -722,6 +789,9 @@ void Definition::setInbodyDocumentation(const char *d,const char *inbodyFile,int
  * The file is scanned for a closing bracket ('}') from \a endLine backward.
  * The line actually containing the bracket is returned via endLine.
  * Note that for VHDL code the bracket search is not done.
+ *
+ * The (filtered) contents of recently used files are cached, so a file
+ * with many members is read only once.
  */
 bool readCodeFragment(const char *fileName,
                       int &startLine,int &endLine,QCString &result)
@@ -731,44 +801,49 @@ bool readCodeFragment(const char *fileName,
   //printf("readCodeFragment(%s,%d,%d)\n",fileName,startLine,endLine);
   if (fileName==0 || fileName[0]==0) return FALSE; // not a valid file name
   QCString filter = getFileFilter(fileName,TRUE);
-  FILE *f=0;
   bool usePipe = !filter.isEmpty() && filterSourceFiles;
   SrcLangExt lang = getLanguageFromFileName(fileName);
-  if (!usePipe) // no filter given or wanted
-  {
-    f = portable_fopen(fileName,"r");
-  }
-  else // use filter
+  SourceFileContents *sfc = g_sourceFileCache.find(fileName);
+  bool cached = sfc!=0;
+  if (!cached)
   {
-    QCString cmd=filter+" \""+fileName+"\"";
-    Debug::print(Debug::ExtCmd,0,"Executing popen(`%s`)\n",qPrint(cmd));
-    f = portable_popen(cmd,"r");
+    sfc = readSourceFileContents(fileName,usePipe,filter);
+    // files larger than the cache are not stored
+    cached = sfc && g_sourceFileCache.insert(fileName,sfc,QMAX(1,sfc->text.length()));
   }
   bool found = lang==SrcLangExt_VHDL   || 
                lang==SrcLangExt_Tcl    || 
                lang==SrcLangExt_Python || 
                lang==SrcLangExt_Fortran;  
                // for VHDL, TCL, Python, and Fortran no bracket search is possible
-  if (f)
+  if (sfc)
   {
+    SourceFileReader f(sfc->text);
     int c=0;
     int col=0;
     int lineNr=1;
     // skip until the startLine has reached
-    while (lineNr<startLine && !feof(f))
+    if (startLine>1)
     {
-      while ((c=fgetc(f))!='\n' && c!=EOF) /* skip */;
-      lineNr++; 
-      if (found && c == '\n') c = '\0';
+      if (startLine-1<(int)sfc->lineStarts.size())
+      {
+        f.seek(sfc->lineStarts[startLine-1]);
+        lineNr=startLine;
+        c = found ? '\0' : '\n';
+      }
+      else // file has less lines
+      {
+        f.seekToEnd();
+      }
     }
-    if (!feof(f))
+    if (!f.eof())
     {
       // skip until the opening bracket or lonely : is found
       char cn=0;
-      while (lineNr<=endLine && !feof(f) && !found)
+      while (lineNr<=endLine && !f.eof() && !found)
       {
         int pc=0;
-        while ((c=fgetc(f))!='{' && c!=':' && c!=EOF)  // } so vi matching brackets has no problem
+        while ((c=f.getc())!='{' && c!=':' && c!=EOF)  // } so vi matching brackets has no problem
         {
           //printf("parsing char `%c'\n",c);
           if (c=='\n') 
@@ -781,12 +856,12 @@ bool readCodeFragment(const char *fileName,
           }
           else if (pc=='/' && c=='/') // skip single line comment
           {
-            while ((c=fgetc(f))!='\n' && c!=EOF) pc=c;
+            while ((c=f.getc())!='\n' && c!=EOF) pc=c;
             if (c=='\n') lineNr++,col=0;
           }
           else if (pc=='/' && c=='*') // skip C style comment
           {
-            while (((c=fgetc(f))!='/' || pc!='*') && c!=EOF) 
+            while (((c=f.getc())!='/' || pc!='*') && c!=EOF) 
             {
               if (c=='\n') lineNr++,col=0;
               pc=c;
@@ -800,7 +875,7 @@ bool readCodeFragment(const char *fileName,
         }
         if (c==':')
         {
-          cn=fgetc(f);
+          cn=f.getc();
           if (cn!=':') found=TRUE;
         }
         else if (c=='{')   // } so vi matching brackets has no problem
@@ -837,7 +912,7 @@ bool readCodeFragment(const char *fileName,
           do 
           {
             // read up to maxLineLength-1 bytes, the last byte being zero
-            char *p = fgets(lineStr, maxLineLength,f);
+            char *p = f.gets(lineStr, maxLineLength);
             //printf("  read %s",p);
             if (p) 
             {
@@ -852,7 +927,7 @@ bool readCodeFragment(const char *fileName,
           } while (size_read == (maxLineLength-1));
 
           lineNr++; 
-        } while (lineNr<=endLine && !feof(f));
+        } while (lineNr<=endLine && !f.eof());
 
         // strip stuff after closing bracket
         int newLineIndex = result.findRev('\n');
@@ -866,14 +941,10 @@ bool readCodeFragment(const char *fileName,
     }
     if (usePipe) 
     {
-      portable_pclose(f); 
       Debug::print(Debug::FilterOutput, 0, "Filter output\n");
       Debug::print(Debug::FilterOutput,0,"-------------\n%s\n-------------\n",qPrint(result));
     }
-    else 
-    {
-      fclose(f);
-    }
+    if (!cached) delete sfc;
   }
   result = transcodeCharacterStringToUTF8(result);
   //fprintf(stderr,"readCodeFragement(%d-%d)=%s\n",startLine,endLine,result.data());
@@ -1400,9 +1471,10 @@ QCString Definition::qualifiedName() const
   }
   else
   {
-    m_impl->qualifiedName = m_impl->outerScope->qualifiedName()+
+    m_impl->qualifiedName = StringPool::intern(
+           m_impl->outerScope->qualifiedName()+
            getLanguageSpecificSeparator(getLanguage())+
-           m_impl->localName;
+           m_impl->localName);
   }
   //printf("end %s::qualifiedName()=%s\n",name().data(),m_impl->qualifiedName.data());
   //count--;
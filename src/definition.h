@@ -61,7 +61,7 @@ struct BodyInfo
     FileDef *fileDef;     //!< file definition containing the function body
 };
     
-/** Abstract interface for a Definition or DefinitionList */
+/** Abstract interface for a Definition */
 class DefinitionIntf
 {
   public:
@@ -77,8 +77,7 @@ class DefinitionIntf
       TypeGroup      = 4, 
       TypePackage    = 5, 
       TypePage       = 6, 
-      TypeDir        = 7, 
-      TypeSymbolList = 8
+      TypeDir        = 7
     };
     /*! Use this for dynamic inspection of the type of the derived class */
     virtual DefType definitionType() const = 0;
@@ -366,28 +365,6 @@ class Definition : public DefinitionIntf
     int m_defColumn;
 };
 
-/** A list of Definition objects. */
-class DefinitionList : public QList<Definition>, public DefinitionIntf
-{
-  public:
-    ~DefinitionList() {}
-    DefType definitionType() const { return TypeSymbolList; }
-    int compareValues(const Definition *item1,const Definition *item2) const
-    {
-      return qstricmp(item1->name(),item2->name());
-    }
-
-};
-
-/** An iterator for Definition objects in a DefinitionList. */
-class DefinitionListIterator : public QListIterator<Definition>
-{
-  public:
-    DefinitionListIterator(const DefinitionList &l) :
-      QListIterator<Definition>(l) {}
-    ~DefinitionListIterator() {}
-};
-
 /** Reads a fragment from file \a fileName starting with line \a startLine
  *  and ending with line \a endLine. The result is returned as a string 
  *  via \a result. The function returns TRUE if successful and FALSE 
@@ -396,4 +373,7 @@ class DefinitionListIterator : public QListIterator<Definition>
 bool readCodeFragment(const char *fileName, 
                       int &startLine,int &endLine,
                       QCString &result);
+
+/** Sets up the cache used by readCodeFragment(). */
+void initSourceFileCache();
 #endif
@@ -99,6 +99,11 @@
 #include "settings.h"
 #include "context.h"
 #include "fileparser.h"
+#include "inputreader.h"
+#include "outputwriter.h"
+#include "parsecache.h"
+#include "symbolmap.h"
+#include "lookupcache.h"
 
 // provided by the generated file resources.cpp
 extern void initResources();
@@ -150,11 +155,11 @@ QDict<RefList>  *Doxygen::xrefLists = new QDict<RefList>; // dictionary of cross
 bool             Doxygen::parseSourcesNeeded = FALSE;
 QTime            Doxygen::runningTime;
 SearchIndexIntf *Doxygen::searchIndex=0;
-QDict<DefinitionIntf> *Doxygen::symbolMap = 0;
+SymbolMap       *Doxygen::symbolMap = 0;
 QDict<Definition> *Doxygen::clangUsrMap = 0;
 bool             Doxygen::outputToWizard=FALSE;
 QDict<int> *     Doxygen::htmlDirMap = 0;
-QCache<LookupInfo> *Doxygen::lookupCache;
+LookupCache     *Doxygen::lookupCache;
 DirSDict        *Doxygen::directories;
 SDict<DirRelation> Doxygen::dirRelations(257);
 ParserManager   *Doxygen::parserManager = 0;
@@ -179,9 +184,53 @@ static QDict<void>      g_compoundKeywordDict(7);  // keywords recognised as com
 static OutputList      *g_outputList = 0;          // list of output generating objects
 static QDict<FileDef>   g_usingDeclarations(1009); // used classes
 static FileStorage     *g_storage = 0;
+static ParseCache      *g_parseCache = 0;      // results of earlier runs
 static bool             g_successfulRun = FALSE;
 static bool             g_dumpSymbolMap = FALSE;
-static bool             g_useOutputTemplate = FALSE; 
+static bool             g_useOutputTemplate = FALSE;
+
+/** A pass over the entry tree that can share its walk with other passes.
+ *  Passes can only be combined if none of them depends on the results of
+ *  the others, since each node is handled by all passes before moving on
+ *  to the next node.
+ */
+struct EntryTreePass
+{
+  bool (*matches)(EntryNav *rootNav); //!< TRUE if the pass handles the node
+  void (*handle)(EntryNav *rootNav);  //!< handles a matching node
+  bool needsEntry;                    //!< TRUE if handle() uses the entry
+};
+
+/** Walks the entry tree once for the \a numPasses passes in \a passes.
+ *  The entry of a node is loaded at most once, and only if one of the
+ *  passes handling the node needs it.
+ */
+static void walkEntryTree(EntryNav *rootNav,const EntryTreePass *passes,int numPasses)
+{
+  bool loaded=FALSE;
+  int i;
+  for (i=0;i<numPasses;i++)
+  {
+    if (passes[i].matches(rootNav))
+    {
+      if (passes[i].needsEntry && !loaded)
+      {
+        rootNav->loadEntry(g_storage);
+        loaded=TRUE;
+      }
+      passes[i].handle(rootNav);
+    }
+  }
+  if (loaded)
+  {
+    rootNav->releaseEntry();
+  }
+  if (rootNav->children())
+  {
+    EntryNavListIterator eli(*rootNav->children());
+    for (;eli.current();++eli) walkEntryTree(eli.current(),passes,numPasses);
+  }
+}
 
 void clearAll()
 {
@@ -213,17 +262,19 @@ void clearAll()
 class Statistics 
 {
   public:
-    Statistics() { stats.setAutoDelete(TRUE); }
+    Statistics() : bytesLoaded(0) { stats.setAutoDelete(TRUE); }
     void begin(const char *name)
     {
       msg(name);
       stat *entry= new stat(name,0);
       stats.append(entry);
       time.restart();
+      bytesLoaded = EntryNav::bytesLoaded();
     }
     void end()
     {
       stats.getLast()->elapsed=((double)time.elapsed())/1000.0;
+      stats.getLast()->bytesLoaded=EntryNav::bytesLoaded()-bytesLoaded;
     }
     void print()
     {
@@ -239,6 +290,11 @@ class Statistics
       for ( sli.toFirst(); (s=sli.current()); ++sli )
       {
         msg("Spent %.3f seconds in %s",s->elapsed,s->name);
+        if (s->bytesLoaded>0)
+        {
+          msg("  (loaded %.1f MB from the entry database)\n",
+              (double)s->bytesLoaded/(1024.0*1024.0));
+        }
       }
       if (restore) Debug::setFlag("time");
     }
@@ -247,11 +303,13 @@ class Statistics
     {
       const char *name;
       double elapsed;
-      stat() : name(NULL),elapsed(0) {}
-      stat(const char *n, double el) : name(n),elapsed(el) {}
+      uint64 bytesLoaded;
+      stat() : name(NULL),elapsed(0),bytesLoaded(0) {}
+      stat(const char *n, double el) : name(n),elapsed(el),bytesLoaded(0) {}
     };
     QList<stat> stats;
     QTime       time;
+    uint64      bytesLoaded;
 } g_s;
 
 
@@ -696,29 +754,30 @@ static void buildGroupList(EntryNav *rootNav)
   buildGroupListFiltered(rootNav,TRUE,TRUE);
 }
 
+static bool isGroupInScope(EntryNav *rootNav)
+{
+  return rootNav->section()==Entry::GROUPDOC_SEC && !rootNav->name().isEmpty() && 
+         rootNav->parent() && !rootNav->parent()->name().isEmpty();
+}
+
 static void findGroupScope(EntryNav *rootNav)
 {
-  if (rootNav->section()==Entry::GROUPDOC_SEC && !rootNav->name().isEmpty() && 
-      rootNav->parent() && !rootNav->parent()->name().isEmpty())
+  GroupDef *gd;
+  if ((gd=Doxygen::groupSDict->find(rootNav->name())))
   {
-    GroupDef *gd;
-    if ((gd=Doxygen::groupSDict->find(rootNav->name())))
+    QCString scope = rootNav->parent()->name();
+    if (rootNav->parent()->section()==Entry::PACKAGEDOC_SEC)
     {
-      QCString scope = rootNav->parent()->name();
-      if (rootNav->parent()->section()==Entry::PACKAGEDOC_SEC)
-      {
-        scope=substitute(scope,".","::");
-      }
-      scope = stripAnonymousNamespaceScope(scope);
-      scope+="::"+gd->name();
-      Definition *d = findScopeFromQualifiedName(Doxygen::globalScope,scope,0,rootNav->tagInfo());
-      if (d) 
-      {
-        gd->setGroupScope(d);
-      }
+      scope=substitute(scope,".","::");
+    }
+    scope = stripAnonymousNamespaceScope(scope);
+    scope+="::"+gd->name();
+    Definition *d = findScopeFromQualifiedName(Doxygen::globalScope,scope,0,rootNav->tagInfo());
+    if (d) 
+    {
+      gd->setGroupScope(d);
     }
   }
-  RECURSE_ENTRYTREE(findGroupScope,rootNav);
 }
 
 static void organizeSubGroupsFiltered(EntryNav *rootNav,bool additional)
@@ -764,81 +823,78 @@ static void organizeSubGroups(EntryNav *rootNav)
 
 //----------------------------------------------------------------------
 
+static bool isFileDocBlock(EntryNav *rootNav)
+{
+  return ((rootNav->section()==Entry::FILEDOC_SEC) ||
+          ((rootNav->section() & Entry::FILE_MASK) && Config_getBool("EXTRACT_ALL"))) &&
+         !rootNav->name().isEmpty() && !rootNav->tagInfo(); // skip any file coming from tag files
+}
+
 static void buildFileList(EntryNav *rootNav)
 {
-  if (((rootNav->section()==Entry::FILEDOC_SEC) ||
-        ((rootNav->section() & Entry::FILE_MASK) && Config_getBool("EXTRACT_ALL"))) &&
-      !rootNav->name().isEmpty() && !rootNav->tagInfo() // skip any file coming from tag files
-     )
-  {
-    rootNav->loadEntry(g_storage);
-    Entry *root = rootNav->entry();
+  Entry *root = rootNav->entry();
 
-    bool ambig;
-    FileDef *fd=findFileDef(Doxygen::inputNameDict,root->name,ambig);
-    //printf("**************** root->name=%s fd=%p\n",root->name.data(),fd);
-    if (fd && !ambig)
-    {
+  bool ambig;
+  FileDef *fd=findFileDef(Doxygen::inputNameDict,root->name,ambig);
+  //printf("**************** root->name=%s fd=%p\n",root->name.data(),fd);
+  if (fd && !ambig)
+  {
 #if 0
-      if ((!root->doc.isEmpty() && !fd->documentation().isEmpty()) ||
-          (!root->brief.isEmpty() && !fd->briefDescription().isEmpty()))
-      {
-        warn(
-            root->fileName,root->startLine,
-            "file %s already documented. "
-            "Skipping documentation.",
-            root->name.data()
-            );
-      }
-      else
+    if ((!root->doc.isEmpty() && !fd->documentation().isEmpty()) ||
+        (!root->brief.isEmpty() && !fd->briefDescription().isEmpty()))
+    {
+      warn(
+          root->fileName,root->startLine,
+          "file %s already documented. "
+          "Skipping documentation.",
+          root->name.data()
+          );
+    }
+    else
 #endif
+    {
+      //printf("Adding documentation!\n");
+      // using FALSE in setDocumentation is small hack to make sure a file 
+      // is documented even if a \file command is used without further 
+      // documentation
+      fd->setDocumentation(root->doc,root->docFile,root->docLine,FALSE);
+      fd->setBriefDescription(root->brief,root->briefFile,root->briefLine); 
+      fd->addSectionsToDefinition(root->anchors);
+      fd->setRefItems(root->sli);
+      QListIterator<Grouping> gli(*root->groups);
+      Grouping *g;
+      for (;(g=gli.current());++gli)
       {
-        //printf("Adding documentation!\n");
-        // using FALSE in setDocumentation is small hack to make sure a file 
-        // is documented even if a \file command is used without further 
-        // documentation
-        fd->setDocumentation(root->doc,root->docFile,root->docLine,FALSE);
-        fd->setBriefDescription(root->brief,root->briefFile,root->briefLine); 
-        fd->addSectionsToDefinition(root->anchors);
-        fd->setRefItems(root->sli);
-        QListIterator<Grouping> gli(*root->groups);
-        Grouping *g;
-        for (;(g=gli.current());++gli)
-        {
-          GroupDef *gd=0;
-          if (!g->groupname.isEmpty() && (gd=Doxygen::groupSDict->find(g->groupname)))
-          {
-            gd->addFile(fd);
-            fd->makePartOfGroup(gd);
-            //printf("File %s: in group %s\n",fd->name().data(),s->data());
-          }
+        GroupDef *gd=0;
+        if (!g->groupname.isEmpty() && (gd=Doxygen::groupSDict->find(g->groupname)))
+        {
+          gd->addFile(fd);
+          fd->makePartOfGroup(gd);
+          //printf("File %s: in group %s\n",fd->name().data(),s->data());
         }
       }
     }
-    else
+  }
+  else
+  {
+    const char *fn = root->fileName.data();
+    QCString text(4096);
+    text.sprintf("the name `%s' supplied as "
+        "the second argument in the \\file statement ",
+        qPrint(root->name));
+    if (ambig) // name is ambiguous
     {
-      const char *fn = root->fileName.data();
-      QCString text(4096);
-      text.sprintf("the name `%s' supplied as "
-          "the second argument in the \\file statement ",
-          qPrint(root->name));
-      if (ambig) // name is ambiguous
-      {
-        text+="matches the following input files:\n";
-        text+=showFileDefMatches(Doxygen::inputNameDict,root->name);
-        text+="Please use a more specific name by "
-          "including a (larger) part of the path!";
-      }
-      else // name is not an input file
-      {
-        text+="is not an input file";
-      }
-      warn(fn,root->startLine,text);
+      text+="matches the following input files:\n";
+      text+=showFileDefMatches(Doxygen::inputNameDict,root->name);
+      text+="Please use a more specific name by "
+        "including a (larger) part of the path!";
     }
-
-    rootNav->releaseEntry();
+    else // name is not an input file
+    {
+      text+="is not an input file";
+    }
+    warn(fn,root->startLine,text);
   }
-  RECURSE_ENTRYTREE(buildFileList,rootNav);
 }
 
 static void addIncludeFile(ClassDef *cd,FileDef *ifd,Entry *root)
@@ -1839,146 +1895,144 @@ static NamespaceDef *findUsedNamespace(NamespaceSDict *unl,
   return usingNd;
 }
 
+static bool isUsingDirective(EntryNav *rootNav)
+{
+  return rootNav->section()==Entry::USINGDIR_SEC;
+}
+
 static void findUsingDirectives(EntryNav *rootNav)
 {
-  if (rootNav->section()==Entry::USINGDIR_SEC)
+  Entry *root = rootNav->entry();
+
+  //printf("Found using directive %s at line %d of %s\n",
+  //    root->name.data(),root->startLine,root->fileName.data());
+  QCString name=substitute(root->name,".","::");
+  if (name.right(2)=="::")
   {
-    rootNav->loadEntry(g_storage);
-    Entry *root = rootNav->entry();
+    name=name.left(name.length()-2);
+  }
+  if (!name.isEmpty())
+  {
+    NamespaceDef *usingNd = 0;
+    NamespaceDef *nd = 0;
+    FileDef      *fd = rootNav->fileDef();
+    QCString nsName;
 
-    //printf("Found using directive %s at line %d of %s\n",
-    //    root->name.data(),root->startLine,root->fileName.data());
-    QCString name=substitute(root->name,".","::");
-    if (name.right(2)=="::")
+    // see if the using statement was found inside a namespace or inside
+    // the global file scope.
+    if (rootNav->parent() && rootNav->parent()->section()==Entry::NAMESPACE_SEC &&
+        (fd==0 || fd->getLanguage()!=SrcLangExt_Java) // not a .java file
+       )
     {
-      name=name.left(name.length()-2);
+      nsName=stripAnonymousNamespaceScope(rootNav->parent()->name());
+      if (!nsName.isEmpty())
+      {
+        nd = getResolvedNamespace(nsName);
+      }
     }
-    if (!name.isEmpty())
-    {
-      NamespaceDef *usingNd = 0;
-      NamespaceDef *nd = 0;
-      FileDef      *fd = rootNav->fileDef();
-      QCString nsName;
 
-      // see if the using statement was found inside a namespace or inside
-      // the global file scope.
-      if (rootNav->parent() && rootNav->parent()->section()==Entry::NAMESPACE_SEC &&
-          (fd==0 || fd->getLanguage()!=SrcLangExt_Java) // not a .java file
-         )
+    // find the scope in which the `using' namespace is defined by prepending
+    // the possible scopes in which the using statement was found, starting
+    // with the most inner scope and going to the most outer scope (i.e. 
+    // file scope). 
+    int scopeOffset = nsName.length();
+    do
+    {
+      QCString scope=scopeOffset>0 ? 
+                    nsName.left(scopeOffset)+"::" : QCString();
+      usingNd = getResolvedNamespace(scope+name);
+      //printf("Trying with scope=`%s' usingNd=%p\n",(scope+name).data(),usingNd);
+      if (scopeOffset==0)
       {
-        nsName=stripAnonymousNamespaceScope(rootNav->parent()->name());
-        if (!nsName.isEmpty())
-        {
-          nd = getResolvedNamespace(nsName);
-        }
+        scopeOffset=-1;
+      }
+      else if ((scopeOffset=nsName.findRev("::",scopeOffset-1))==-1)
+      {
+        scopeOffset=0;
       }
+    } while (scopeOffset>=0 && usingNd==0);
 
-      // find the scope in which the `using' namespace is defined by prepending
-      // the possible scopes in which the using statement was found, starting
-      // with the most inner scope and going to the most outer scope (i.e. 
-      // file scope). 
-      int scopeOffset = nsName.length();
-      do
+    if (usingNd==0 && nd) // not found, try used namespaces in this scope
+                          // or in one of the parent namespace scopes
+    {
+      NamespaceDef *pnd = nd;
+      while (pnd && usingNd==0)
       {
-        QCString scope=scopeOffset>0 ? 
-                      nsName.left(scopeOffset)+"::" : QCString();
-        usingNd = getResolvedNamespace(scope+name);
-        //printf("Trying with scope=`%s' usingNd=%p\n",(scope+name).data(),usingNd);
-        if (scopeOffset==0)
+        // also try with one of the used namespaces found earlier
+        usingNd = findUsedNamespace(pnd->getUsedNamespaces(),name);
+
+        // goto the parent
+        Definition *s = pnd->getOuterScope();
+        if (s && s->definitionType()==Definition::TypeNamespace)
         {
-          scopeOffset=-1;
+          pnd = (NamespaceDef*)s;
         }
-        else if ((scopeOffset=nsName.findRev("::",scopeOffset-1))==-1)
+        else
         {
-          scopeOffset=0;
+          pnd = 0;
         }
-      } while (scopeOffset>=0 && usingNd==0);
+      }
+    }
+    if (usingNd==0 && fd) // still nothing, also try used namespace in the
+                          // global scope
+    {
+      usingNd = findUsedNamespace(fd->getUsedNamespaces(),name);
+    }
 
-      if (usingNd==0 && nd) // not found, try used namespaces in this scope
-                            // or in one of the parent namespace scopes
-      {
-        NamespaceDef *pnd = nd;
-        while (pnd && usingNd==0)
-        {
-          // also try with one of the used namespaces found earlier
-          usingNd = findUsedNamespace(pnd->getUsedNamespaces(),name);
+    //printf("%s -> %s\n",name.data(),usingNd?usingNd->name().data():"<none>");
 
-          // goto the parent
-          Definition *s = pnd->getOuterScope();
-          if (s && s->definitionType()==Definition::TypeNamespace)
-          {
-            pnd = (NamespaceDef*)s;
-          }
-          else
-          {
-            pnd = 0;
-          }
-        }
+    // add the namespace the correct scope
+    if (usingNd)
+    {
+      //printf("using fd=%p nd=%p\n",fd,nd);
+      if (nd)
+      {
+        //printf("Inside namespace %s\n",nd->name().data());
+        nd->addUsingDirective(usingNd);
       }
-      if (usingNd==0 && fd) // still nothing, also try used namespace in the
-                            // global scope
+      else if (fd)
       {
-        usingNd = findUsedNamespace(fd->getUsedNamespaces(),name);
+        //printf("Inside file %s\n",fd->name().data());
+        fd->addUsingDirective(usingNd);
       }
+    }
+    else // unknown namespace, but add it anyway.
+    {
+      //printf("++ new unknown namespace %s lang=%s\n",name.data(),langToString(root->lang).data());
+      NamespaceDef *nd=new NamespaceDef(root->fileName,root->startLine,root->startColumn,name);
+      nd->setDocumentation(root->doc,root->docFile,root->docLine); // copy docs to definition
+      nd->setBriefDescription(root->brief,root->briefFile,root->briefLine);
+      nd->addSectionsToDefinition(root->anchors);
+      //printf("** Adding namespace %s hidden=%d\n",name.data(),root->hidden);
+      nd->setHidden(root->hidden);
+      nd->setArtificial(TRUE);
+      nd->setLanguage(root->lang);
+      nd->setId(root->id);
 
-      //printf("%s -> %s\n",name.data(),usingNd?usingNd->name().data():"<none>");
-
-      // add the namespace the correct scope
-      if (usingNd)
+      QListIterator<Grouping> gli(*root->groups);
+      Grouping *g;
+      for (;(g=gli.current());++gli)
       {
-        //printf("using fd=%p nd=%p\n",fd,nd);
-        if (nd)
-        {
-          //printf("Inside namespace %s\n",nd->name().data());
-          nd->addUsingDirective(usingNd);
-        }
-        else if (fd)
-        {
-          //printf("Inside file %s\n",fd->name().data());
-          fd->addUsingDirective(usingNd);
-        }
+        GroupDef *gd=0;
+        if (!g->groupname.isEmpty() && (gd=Doxygen::groupSDict->find(g->groupname)))
+          gd->addNamespace(nd);
       }
-      else // unknown namespace, but add it anyway.
-      {
-        //printf("++ new unknown namespace %s lang=%s\n",name.data(),langToString(root->lang).data());
-        NamespaceDef *nd=new NamespaceDef(root->fileName,root->startLine,root->startColumn,name);
-        nd->setDocumentation(root->doc,root->docFile,root->docLine); // copy docs to definition
-        nd->setBriefDescription(root->brief,root->briefFile,root->briefLine);
-        nd->addSectionsToDefinition(root->anchors);
-        //printf("** Adding namespace %s hidden=%d\n",name.data(),root->hidden);
-        nd->setHidden(root->hidden);
-        nd->setArtificial(TRUE);
-        nd->setLanguage(root->lang);
-        nd->setId(root->id);
-
-        QListIterator<Grouping> gli(*root->groups);
-        Grouping *g;
-        for (;(g=gli.current());++gli)
-        {
-          GroupDef *gd=0;
-          if (!g->groupname.isEmpty() && (gd=Doxygen::groupSDict->find(g->groupname)))
-            gd->addNamespace(nd);
-        }
 
-        // insert the namespace in the file definition
-        if (fd) 
-        {
-          fd->insertNamespace(nd);
-          fd->addUsingDirective(nd);
-        }
-
-        // the empty string test is needed for extract all case
-        nd->setBriefDescription(root->brief,root->briefFile,root->briefLine);
-        nd->insertUsedFile(fd);
-        // add class to the list
-        Doxygen::namespaceSDict->inSort(name,nd);
-        nd->setRefItems(root->sli);
+      // insert the namespace in the file definition
+      if (fd) 
+      {
+        fd->insertNamespace(nd);
+        fd->addUsingDirective(nd);
       }
-    }
 
-    rootNav->releaseEntry();
+      // the empty string test is needed for extract all case
+      nd->setBriefDescription(root->brief,root->briefFile,root->briefLine);
+      nd->insertUsedFile(fd);
+      // add class to the list
+      Doxygen::namespaceSDict->inSort(name,nd);
+      nd->setRefItems(root->sli);
+    }
   }
-  RECURSE_ENTRYTREE(findUsingDirectives,rootNav);
 }
 
 //----------------------------------------------------------------------
@@ -8338,15 +8392,7 @@ static void flushCachedTemplateRelations()
   // as there can be new template instances in the inheritance path
   // to this class. Optimization: only remove those classes that
   // have inheritance instances as direct or indirect sub classes.
-  QCacheIterator<LookupInfo> ci(*Doxygen::lookupCache);
-  LookupInfo *li=0;
-  for (ci.toFirst();(li=ci.current());++ci)
-  {
-    if (li->classDef)
-    {
-      Doxygen::lookupCache->remove(ci.currentKey());
-    }
-  }
+  Doxygen::lookupCache->removeClasses();
   // remove all cached typedef resolutions whose target is a
   // template class as this may now be a template instance
   MemberNameSDict::Iterator fnli(*Doxygen::functionNameSDict);
@@ -8394,15 +8440,7 @@ static void flushUnresolvedRelations()
   // class B : public A {};
   // class C : public B::I {};
   //
-  QCacheIterator<LookupInfo> ci(*Doxygen::lookupCache);
-  LookupInfo *li=0;
-  for (ci.toFirst();(li=ci.current());++ci)
-  {
-    if (li->classDef==0 && li->typeDef==0)
-    {
-      Doxygen::lookupCache->remove(ci.currentKey());
-    }
-  }
+  Doxygen::lookupCache->removeUnresolved();
 
   MemberNameSDict::Iterator fnli(*Doxygen::functionNameSDict);
   MemberName *fn;
@@ -8643,15 +8681,11 @@ static void findDirDocumentation(EntryNav *rootNav)
 
 static void buildPageList(EntryNav *rootNav)
 {
-  if (rootNav->section() == Entry::PAGEDOC_SEC)
+  if (rootNav->section() == Entry::PAGEDOC_SEC && !rootNav->name().isEmpty())
   {
     rootNav->loadEntry(g_storage);
-    Entry *root = rootNav->entry();
 
-    if (!root->name.isEmpty())
-    {
-      addRelatedPage(rootNav);
-    }
+    addRelatedPage(rootNav);
 
     rootNav->releaseEntry();
   }
@@ -8680,11 +8714,12 @@ static void buildPageList(EntryNav *rootNav)
 // search for the main page defined in this project
 static void findMainPage(EntryNav *rootNav)
 {
-  if (rootNav->section() == Entry::MAINPAGEDOC_SEC)
+  // main pages from tag files are handled by findMainPageTagFiles()
+  if (rootNav->section() == Entry::MAINPAGEDOC_SEC && rootNav->tagInfo()==0)
   {
     rootNav->loadEntry(g_storage);
 
-    if (Doxygen::mainPage==0 && rootNav->tagInfo()==0)
+    if (Doxygen::mainPage==0)
     {
       Entry *root = rootNav->entry();
       //printf("Found main page! \n======\n%s\n=======\n",root->doc.data());
@@ -8724,7 +8759,7 @@ static void findMainPage(EntryNav *rootNav)
         Doxygen::mainPage->addSectionsToDefinition(root->anchors);
       }
     }
-    else if (rootNav->tagInfo()==0)
+    else
     {
       Entry *root = rootNav->entry();
       warn(root->fileName,root->startLine,
@@ -8740,52 +8775,49 @@ static void findMainPage(EntryNav *rootNav)
 // search for the main page imported via tag files and add only the section labels
 static void findMainPageTagFiles(EntryNav *rootNav)
 {
-  if (rootNav->section() == Entry::MAINPAGEDOC_SEC)
+  if (rootNav->section() == Entry::MAINPAGEDOC_SEC && 
+      Doxygen::mainPage && rootNav->tagInfo())
   {
     rootNav->loadEntry(g_storage);
+    Entry *root = rootNav->entry();
 
-    if (Doxygen::mainPage && rootNav->tagInfo())
-    {
-      Entry *root = rootNav->entry();
-      Doxygen::mainPage->addSectionsToDefinition(root->anchors);
-    }
+    Doxygen::mainPage->addSectionsToDefinition(root->anchors);
+
+    rootNav->releaseEntry();
   }
   RECURSE_ENTRYTREE(findMainPageTagFiles,rootNav);
 }
 
+static bool isPageWithName(EntryNav *rootNav)
+{
+  return (rootNav->section()==Entry::PAGEDOC_SEC || 
+          rootNav->section()==Entry::MAINPAGEDOC_SEC
+         )
+         && !rootNav->name().isEmpty();
+}
+
 static void computePageRelations(EntryNav *rootNav)
 {
-  if ((rootNav->section()==Entry::PAGEDOC_SEC || 
-       rootNav->section()==Entry::MAINPAGEDOC_SEC
-      )
-      && !rootNav->name().isEmpty()
-     )
-  {
-    rootNav->loadEntry(g_storage);
-    Entry *root = rootNav->entry();
+  Entry *root = rootNav->entry();
 
-    PageDef *pd = root->section==Entry::PAGEDOC_SEC ?
-                    Doxygen::pageSDict->find(root->name) : 
-                    Doxygen::mainPage; 
-    if (pd)
+  PageDef *pd = root->section==Entry::PAGEDOC_SEC ?
+                  Doxygen::pageSDict->find(root->name) : 
+                  Doxygen::mainPage; 
+  if (pd)
+  {
+    QListIterator<BaseInfo> bii(*root->extends);
+    BaseInfo *bi;
+    for (bii.toFirst();(bi=bii.current());++bii)
     {
-      QListIterator<BaseInfo> bii(*root->extends);
-      BaseInfo *bi;
-      for (bii.toFirst();(bi=bii.current());++bii)
+      PageDef *subPd = Doxygen::pageSDict->find(bi->name);
+      if (subPd)
       {
-        PageDef *subPd = Doxygen::pageSDict->find(bi->name);
-        if (subPd)
-        {
-          pd->addInnerCompound(subPd);
-          //printf("*** Added subpage relation: %s->%s\n",
-          //    pd->name().data(),subPd->name().data());
-        }
+        pd->addInnerCompound(subPd);
+        //printf("*** Added subpage relation: %s->%s\n",
+        //    pd->name().data(),subPd->name().data());
       }
     }
-
-    rootNav->releaseEntry();
   }
-  RECURSE_ENTRYTREE(computePageRelations,rootNav);
 }
 
 static void checkPageRelations()
@@ -9334,9 +9366,13 @@ static ParserInterface *getParserForFile(const char *fn)
   return Doxygen::parserManager->getParser(extension);
 }
 
+/*! Parses input file \a fn using \a parser. If \a fileBuf is not 0 it 
+ *  holds the contents of the file as read by readInputFile(), otherwise
+ *  the file is read here.
+ */
 static void parseFile(ParserInterface *parser,
                       Entry *root,EntryNav *rootNav,FileDef *fd,const char *fn,
-                      bool sameTu,QStrList &filesInSameTu)
+                      bool sameTu,QStrList &filesInSameTu,BufStr *fileBuf=0)
 {
 #if USE_LIBCLANG
   static bool clangAssistedParsing = Config_getBool("CLANG_ASSISTED_PARSING");
@@ -9355,41 +9391,90 @@ static void parseFile(ParserInterface *parser,
     extension = ".no_extension";
   }
 
+  bool preprocess = Config_getBool("ENABLE_PREPROCESSING") && 
+                    parser->needsPreprocessing(extension);
   QFileInfo fi(fileName);
-  BufStr preBuf(fi.size()+4096);
+  // input for the comment conversion, the file contents read ahead are
+  // used as is if they do not need preprocessing
+  BufStr preBuf(fileBuf && !preprocess ? 1 : fi.size()+4096);
+  BufStr *srcBuf = &preBuf;
 
-  if (Config_getBool("ENABLE_PREPROCESSING") && 
-      parser->needsPreprocessing(extension))
+  if (preprocess)
   {
-    BufStr inBuf(fi.size()+4096);
     msg("Preprocessing %s...\n",fn);
-    readInputFile(fileName,inBuf);
-    preprocessFile(fileName,inBuf,preBuf);
+    if (fileBuf) // already read ahead
+    {
+      preprocessFile(fileName,*fileBuf,preBuf);
+      fileBuf->shrink(0); // not needed anymore
+    }
+    else
+    {
+      BufStr inBuf(fi.size()+4096);
+      readInputFile(fileName,inBuf);
+      preprocessFile(fileName,inBuf,preBuf);
+    }
   }
   else // no preprocessing
   {
     msg("Reading %s...\n",fn);
-    readInputFile(fileName,preBuf);
+    if (fileBuf) // already read ahead
+    {
+      srcBuf = fileBuf;
+    }
+    else
+    {
+      readInputFile(fileName,preBuf);
+    }
   }
-  if (preBuf.data() && preBuf.curPos()>0 && *(preBuf.data()+preBuf.curPos()-1)!='\n')
+  if (srcBuf->data() && srcBuf->curPos()>0 && *(srcBuf->data()+srcBuf->curPos()-1)!='\n')
   {
-    preBuf.addChar('\n'); // add extra newline to help parser
+    srcBuf->addChar('\n'); // add extra newline to help parser
   }
 
-  BufStr convBuf(preBuf.curPos()+1024);
+  BufStr convBuf(srcBuf->curPos()+1024);
 
   // convert multi-line C++ comments to C style comments
-  convertCppComments(&preBuf,&convBuf,fileName);
+  convertCppComments(srcBuf,&convBuf,fileName);
 
   convBuf.addChar('\0');
 
+  // only the converted input is needed from here on, so release the
+  // other buffers before parsing to limit the memory in use at once
+  srcBuf->shrink(0);
+
   if (clangAssistedParsing && !sameTu)
   {
     fd->getAllIncludeFilesRecursively(filesInSameTu);
   }
 
+  bool useCache = g_parseCache && ParseCache::isCacheable(fileName);
+  if (useCache)
+  {
+    Entry *cachedRoot = g_parseCache->load(fileName,convBuf.data(),convBuf.curPos());
+    if (cachedRoot) // same input as an earlier run
+    {
+      msg("Reading parse result for %s from cache...\n",fn);
+      root->lang = cachedRoot->lang;
+      cachedRoot->createNavigationIndex(rootNav,g_storage,fd);
+      delete cachedRoot;
+      return;
+    }
+  }
+
   // use language parse to parse the file
+  uint64 numEntries  = Entry::numCreated();
+  uint64 numArgLists = ArgumentList::numCreated();
+  uint64 numArgs     = Argument::numCreated();
   parser->parseInput(fileName,convBuf.data(),root,sameTu,filesInSameTu);
+  Debug::print(Debug::Entries,0,"%s: %d entries, %d argument lists and %d arguments allocated while parsing\n",
+               fn,(int)(Entry::numCreated()-numEntries),
+               (int)(ArgumentList::numCreated()-numArgLists),
+               (int)(Argument::numCreated()-numArgs));
+
+  if (useCache)
+  {
+    g_parseCache->store(root);
+  }
 
   // store the Entry tree in a file and create an index to
   // navigate/load entries
@@ -9473,15 +9558,59 @@ static void parseFiles(Entry *root,EntryNav *rootNav)
   {
     StringListIterator it(g_inputFiles);
     QCString *s;
-    for (;(s=it.current());++it)
+    QCString cacheDir = Config_getString("PARSE_CACHE_DIRECTORY");
+    if (!cacheDir.isEmpty())
     {
-      bool ambig;
-      QStrList filesInSameTu;
-      FileDef *fd=findFileDef(Doxygen::inputNameDict,s->data(),ambig);
-      ASSERT(fd!=0);
-      ParserInterface * parser = getParserForFile(s->data());
-      parser->startTranslationUnit(s->data());
-      parseFile(parser,root,rootNav,fd,s->data(),FALSE,filesInSameTu);
+      g_parseCache = new ParseCache(cacheDir);
+    }
+    int numThreads = Config_getInt("NUM_PARSE_THREADS");
+    if (numThreads!=1) // read the files ahead of the parser using threads
+    {
+      InputFileReader reader(numThreads);
+      for (;(s=it.current());++it)
+      {
+        reader.addFile(*s);
+      }
+      if (reader.numThreads()>0)
+      {
+        msg("Reading input files using %d parallel threads...\n",reader.numThreads());
+      }
+      InputFileJob *job;
+      for (it.toFirst();(job=reader.takeNext());++it)
+      {
+        s=it.current();
+        ASSERT(s!=0 && *s==job->fileName());
+        bool ambig;
+        QStrList filesInSameTu;
+        FileDef *fd=findFileDef(Doxygen::inputNameDict,s->data(),ambig);
+        ASSERT(fd!=0);
+        ParserInterface * parser = getParserForFile(s->data());
+        parser->startTranslationUnit(s->data());
+        parseFile(parser,root,rootNav,fd,s->data(),FALSE,filesInSameTu,
+                  job->buffer());
+        delete job;
+      }
+    }
+    else
+    {
+      for (;(s=it.current());++it)
+      {
+        bool ambig;
+        QStrList filesInSameTu;
+        FileDef *fd=findFileDef(Doxygen::inputNameDict,s->data(),ambig);
+        ASSERT(fd!=0);
+        ParserInterface * parser = getParserForFile(s->data());
+        parser->startTranslationUnit(s->data());
+        parseFile(parser,root,rootNav,fd,s->data(),FALSE,filesInSameTu);
+      }
+    }
+    if (g_parseCache)
+    {
+      msg("Parse cache: %d hits, %d misses\n",
+          g_parseCache->hits(),g_parseCache->misses());
+      g_parseCache->removeUnused();
+      delete g_parseCache;
+      g_parseCache = 0;
     }
   }
 }
@@ -9909,23 +10038,15 @@ static void dumpSymbolMap()
   if (f.open(IO_WriteOnly))
   {
     FTextStream t(&f);
-    QDictIterator<DefinitionIntf> di(*Doxygen::symbolMap);
-    DefinitionIntf *intf;
-    for (;(intf=di.current());++di)
+    SymbolMap::Iterator si(*Doxygen::symbolMap);
+    const SymbolList *sl;
+    for (;(sl=si.current());++si)
     {
-      if (intf->definitionType()==DefinitionIntf::TypeSymbolList) // list of symbols
+      // for each symbol
+      uint i;
+      for (i=0;i<sl->count();i++)
       {
-        DefinitionListIterator dli(*(DefinitionList*)intf);
-        Definition *d;
-        // for each symbol
-        for (dli.toFirst();(d=dli.current());++dli)
-        {
-          dumpSymbol(t,d);
-        }
-      }
-      else // single symbol
-      {
-        Definition *d = (Definition *)intf;
+        Definition *d = sl->at(i);
         if (d!=Doxygen::globalScope) dumpSymbol(t,d);
       }
     }
@@ -10001,6 +10122,11 @@ void initDoxygen()
 
   Doxygen::runningTime.start();
   initPreprocessor();
+  initSourceFileCache();
+  initFuncDeclCache();
+  initArgumentListCache();
+  initResolveCache();
+  initCanonicalTypeCache();
 
   Doxygen::parserManager = new ParserManager;
   Doxygen::parserManager->registerDefaultParser(         new FileParser);
@@ -10021,7 +10147,7 @@ void initDoxygen()
   initNamespaceMemberIndices();
   initFileMemberIndices();
 
-  Doxygen::symbolMap     = new QDict<DefinitionIntf>(50177);
+  Doxygen::symbolMap     = new SymbolMap;
 #ifdef USE_LIBCLANG
   Doxygen::clangUsrMap   = new QDict<Definition>(50177);
 #endif
@@ -10108,26 +10234,6 @@ void cleanUpDoxygen()
   Mappers::freeMappers();
   codeFreeScanner();
 
-  if (Doxygen::symbolMap)
-  {
-    // iterate through Doxygen::symbolMap and delete all
-    // DefinitionList objects, since they have no owner
-    QDictIterator<DefinitionIntf> dli(*Doxygen::symbolMap);
-    DefinitionIntf *di;
-    for (dli.toFirst();(di=dli.current());)
-    {
-      if (di->definitionType()==DefinitionIntf::TypeSymbolList)
-      {
-        DefinitionIntf *tmp = Doxygen::symbolMap->take(dli.currentKey());
-        delete (DefinitionList *)tmp;
-      }
-      else
-      {
-        ++dli;
-      }
-    } 
-  }
-
   delete Doxygen::inputNameList;
   delete Doxygen::memberNameSDict;
   delete Doxygen::functionNameSDict;
@@ -10933,13 +11039,13 @@ void parseInput()
 
   Doxygen::symbolStorage = new Store;
 
-  // also scale lookup cache with SYMBOL_CACHE_SIZE
+  // the lookup cache starts with the size given by LOOKUP_CACHE_SIZE,
+  // and grows with the number of symbols when needed
   int cacheSize = Config_getInt("LOOKUP_CACHE_SIZE");
   if (cacheSize<0) cacheSize=0;
   if (cacheSize>9) cacheSize=9;
   uint lookupSize = 65536 << cacheSize;
-  Doxygen::lookupCache = new QCache<LookupInfo>(lookupSize,lookupSize);
-  Doxygen::lookupCache->setAutoDelete(TRUE);
+  Doxygen::lookupCache = new LookupCache(lookupSize);
 
 #ifdef HAS_SIGNALS
   signal(SIGINT, stopDoxygen);
@@ -11113,6 +11219,10 @@ void parseInput()
   preFreeScanner();
   scanFreeScanner();
   pyscanFreeScanner();
+  // the entry trees of all files are in the storage now, so also release
+  // the pool memory they used
+  Entry::trimPool();
+  ArgumentList::trimPools();
 
   if (!g_storage->open(IO_ReadOnly))
   {
@@ -11137,11 +11247,19 @@ void parseInput()
 
   g_s.begin("Building namespace list...\n");
   buildNamespaceList(rootNav);
-  findUsingDirectives(rootNav);
   g_s.end();
 
+  // the using directives and the file documentation are independent, 
+  // so they are handled in a single walk over the entry tree
   g_s.begin("Building file list...\n");
-  buildFileList(rootNav);
+  {
+    static const EntryTreePass passes[] =
+    {
+      { isUsingDirective, findUsingDirectives, TRUE },
+      { isFileDocBlock,   buildFileList,       TRUE }
+    };
+    walkEntryTree(rootNav,passes,2);
+  }
   g_s.end();
   //generateFileTree();
 
@@ -11255,6 +11373,10 @@ void parseInput()
   findEnumDocumentation(rootNav);
   g_s.end();
 
+  // the classes and typedefs are known now, so the canonical types used
+  // to match argument lists can be kept
+  setCanonicalTypeCacheEnabled(TRUE);
+
   g_s.begin("Searching for member function documentation...\n");
   findObjCMethodDefinitions(rootNav);
   findMemberDocumentation(rootNav); // may introduce new members !
@@ -11272,15 +11394,18 @@ void parseInput()
   findMainPageTagFiles(rootNav);
   g_s.end();
 
-  g_s.begin("Computing page relations...\n");
-  computePageRelations(rootNav);
+  g_s.begin("Computing page relations and the scope of groups...\n");
+  {
+    static const EntryTreePass passes[] =
+    {
+      { isPageWithName, computePageRelations, TRUE  },
+      { isGroupInScope, findGroupScope,       FALSE }
+    };
+    walkEntryTree(rootNav,passes,2);
+  }
   checkPageRelations();
   g_s.end();
 
-  g_s.begin("Determining the scope of groups...\n");
-  findGroupScope(rootNav);
-  g_s.end();
-
   g_s.begin("Sorting lists...\n");
   Doxygen::memberNameSDict->sort();
   Doxygen::functionNameSDict->sort();
@@ -11403,6 +11528,11 @@ void generateOutput()
     exit(0);
   }
 
+  // the relations between the symbols are known now, so the results of
+  // accessibility checks and resolved references can be kept
+  setAccessCacheEnabled(TRUE);
+  setResolveCacheEnabled(TRUE);
+
   initSearchIndexer();
 
   bool generateHtml  = Config_getBool("GENERATE_HTML");
@@ -11570,6 +11700,14 @@ void generateOutput()
     writeIndexHierarchy(*g_outputList);
   }
 
+  // the output files may be post-processed from here on, so make sure
+  // they are all written
+  if (!OutputFileWriter::instance()->finish())
+  {
+    err("Failed to write the output files!\n");
+    exit(1);
+  }
+
   g_s.begin("finalizing index lists...\n");
   Doxygen::indexList->finalize();
   g_s.end();
@@ -11714,6 +11852,19 @@ void generateOutput()
   {
     msg("Note: based on cache misses the ideal setting for LOOKUP_CACHE_SIZE is %d at the cost of higher memory usage.\n",cacheParam);
   }
+  {
+    uint count,size,hits,misses,simple;
+    funcDeclCacheStats(hits,misses);
+    msg("declaration cache hits=%d misses=%d\n",hits,misses);
+    argumentListCacheStats(hits,misses,simple);
+    msg("argument list cache hits=%d misses=%d simple=%d\n",hits,misses,simple);
+    accessCacheStats(count,hits,misses);
+    msg("access cache used %d hits=%d misses=%d\n",count,hits,misses);
+    resolveCacheStats(count,size,hits,misses);
+    msg("reference cache used %d/%d hits=%d misses=%d\n",count,size,hits,misses);
+    canonicalTypeCacheStats(count,size,hits,misses);
+    msg("canonical type cache used %d/%d hits=%d misses=%d\n",count,size,hits,misses);
+  }
 
   if (Debug::isFlagSet(Debug::Time))
   {
@@ -55,6 +55,8 @@ class FileNameList;
 class NamespaceSDict;
 class NamespaceDef;
 class DefinitionIntf;
+class SymbolMap;
+class LookupCache;
 class DirSDict;
 class DirRelation;
 class IndexList;
@@ -76,17 +78,6 @@ class StringDict : public QDict<QCString>
     virtual ~StringDict() {}
 };
 
-struct LookupInfo
-{
-  LookupInfo() : classDef(0), typeDef(0) {}
-  LookupInfo(ClassDef *cd,MemberDef *td,QCString ts,QCString rt) 
-    : classDef(cd), typeDef(td), templSpec(ts),resolvedType(rt) {}
-  ClassDef  *classDef;
-  MemberDef *typeDef;
-  QCString   templSpec;
-  QCString   resolvedType;
-};
-
 extern QCString g_spaces;
 
 /*! \brief This class serves as a namespace for global variables used by doxygen.
@@ -131,11 +122,11 @@ class Doxygen
     static bool                      parseSourcesNeeded;
     static QTime                     runningTime;
     static SearchIndexIntf          *searchIndex;
-    static QDict<DefinitionIntf>    *symbolMap;
+    static SymbolMap                *symbolMap;
     static QDict<Definition>        *clangUsrMap;
     static bool                      outputToWizard;
     static QDict<int>               *htmlDirMap;
-    static QCache<LookupInfo>       *lookupCache;
+    static LookupCache              *lookupCache;
     static DirSDict                 *directories;
     static SDict<DirRelation>        dirRelations;
     static ParserManager            *parserManager;
@@ -16,7 +16,9 @@
  */
 
 #include <stdlib.h>
+#include <new>
 #include <qfile.h>
+#include "objpool.h"
 #include "entry.h"
 #include "marshal.h"
 #include "util.h"
@@ -32,11 +34,38 @@
 //------------------------------------------------------------------
 
 int Entry::num=0;
+uint64 Entry::s_numCreated=0;
+
+//------------------------------------------------------------------
+
+static ObjPool g_entryPool(sizeof(Entry));
+
+void *Entry::operator new(size_t size)
+{
+  if (size==sizeof(Entry)) return g_entryPool.alloc();
+  void *p = malloc(size);
+  if (p==0) throw std::bad_alloc();
+  return p;
+}
+
+void Entry::operator delete(void *p,size_t size)
+{
+  if (p==0) return;
+  if (size==sizeof(Entry)) g_entryPool.free(p); else ::free(p);
+}
+
+void Entry::trimPool()
+{
+  g_entryPool.trim();
+}
+
+//------------------------------------------------------------------
 
 Entry::Entry()
 {
   //printf("Entry::Entry(%p)\n",this);
   num++;
+  s_numCreated++;
   m_parent=0;
   section = EMPTY_SEC;
   m_sublist = new QList<Entry>;
@@ -64,6 +93,7 @@ Entry::Entry(const Entry &e)
 {
   //printf("Entry::Entry(%p):copy\n",this);
   num++;
+  s_numCreated++;
   section     = e.section;
   type        = e.type;
   name        = e.name;
@@ -328,6 +358,8 @@ Entry *Entry::removeSubEntry(Entry *e)
 //------------------------------------------------------------------
 
 
+uint64 EntryNav::s_bytesLoaded = 0;
+
 EntryNav::EntryNav(EntryNav *parent, Entry *e)
              : m_parent(parent), m_subList(0), m_section(e->section), m_type(e->type),
               m_name(e->name), m_fileDef(0), m_lang(e->lang), 
@@ -398,6 +430,7 @@ bool EntryNav::loadEntry(FileStorage *storage)
   }
   if (m_info)  delete m_info;
   m_info = unmarshalEntry(storage);
+  s_bytesLoaded += storage->pos()-m_offset;
   m_info->name = m_name;
   m_info->type = m_type;
   m_info->section = m_section;
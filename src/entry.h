@@ -292,6 +292,20 @@ class Entry
 
     static int  num;          //!< counts the total number of entries
 
+    /** Returns the number of entries created so far. */
+    static uint64 numCreated() { return s_numCreated; }
+
+    /** Entries are allocated from a pool, since many of them are created
+     *  and destroyed, both while parsing and while loading them back from
+     *  the storage. The pool is not locked, so entries may only be
+     *  created and deleted from the main thread.
+     */
+    void *operator new(size_t size);
+    void operator delete(void *p,size_t size);
+
+    /** Releases the memory of the pool that no longer holds entries. */
+    static void trimPool();
+
     /// return the command name used to define GROUPDOC_SEC
     const char *groupDocCmd() const
     {
@@ -322,7 +336,8 @@ class Entry
     void createSubtreeIndex(EntryNav *nav,FileStorage *storage,FileDef *fd);
     Entry         *m_parent;    //!< parent node in the tree
     QList<Entry>  *m_sublist;   //!< entries that are children of this one
-    Entry &operator=(const Entry &); 
+    Entry &operator=(const Entry &);
+    static uint64 s_numCreated; 
 };
 
 /** Wrapper for a node in the Entry tree.
@@ -353,7 +368,11 @@ class EntryNav
     EntryNav *parent() const { return m_parent; }
     FileDef *fileDef() const { return m_fileDef; }
 
+    /** Returns the total number of bytes read by loadEntry() so far. */
+    static uint64 bytesLoaded() { return s_bytesLoaded; }
+
   private:
+    static uint64    s_bytesLoaded;
 
     // navigation 
     EntryNav        *m_parent;    //!< parent node in the tree
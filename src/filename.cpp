@@ -19,7 +19,41 @@
 #include "util.h"
 #include "config.h"
 
-FileName::FileName(const char *fn,const char *n) : FileList()
+/** Node in the index of the paths of the files with the same name.
+ *
+ *  The index is a trie over the characters of the paths from the last to
+ *  the first, so the paths ending with a given string are the ones below
+ *  the node reached by following that string backwards. Each node stores
+ *  how many paths that are, and the last of their files in the list.
+ */
+struct FileName::PathNode
+{
+  PathNode(char ch) : c(ch), count(0), last(0), children(0), next(0) {}
+ ~PathNode()
+  {
+    PathNode *n = children;
+    while (n)
+    {
+      PathNode *next = n->next;
+      delete n;
+      n = next;
+    }
+  }
+  PathNode *child(char ch) const
+  {
+    PathNode *n = children;
+    while (n && n->c!=ch) n=n->next;
+    return n;
+  }
+  char      c;
+  int       count;
+  FileDef  *last;
+  PathNode *children;
+  PathNode *next;
+};
+
+FileName::FileName(const char *fn,const char *n) : FileList(),
+  m_pathIndex(0), m_pathIndexCount(0)
 {
   setAutoDelete(TRUE);
   fName=fn;
@@ -28,6 +62,56 @@ FileName::FileName(const char *fn,const char *n) : FileList()
 
 FileName::~FileName()
 {
+  delete m_pathIndex;
+}
+
+void FileName::buildPathIndex()
+{
+  delete m_pathIndex;
+  m_pathIndex = new PathNode(0);
+  QListIterator<FileDef> it(*this);
+  FileDef *fd;
+  for (;(fd=it.current());++it)
+  {
+    QCString path = stripFromIncludePath(fd->getPath());
+    PathNode *node = m_pathIndex;
+    node->count++;
+    node->last=fd;
+    int i;
+    for (i=path.length()-1;i>=0;i--)
+    {
+      char c = path.at(i);
+      PathNode *n = node->child(c);
+      if (n==0)
+      {
+        n = new PathNode(c);
+        n->next = node->children;
+        node->children = n;
+      }
+      n->count++;
+      n->last=fd;
+      node=n;
+    }
+  }
+  m_pathIndexCount = count();
+}
+
+FileDef *FileName::findByPath(const QCString &path,int &count)
+{
+  // files are only appended to the list, so the index is complete
+  // as long as the number of files did not change
+  if (m_pathIndex==0 || m_pathIndexCount!=this->count())
+  {
+    buildPathIndex();
+  }
+  PathNode *node = m_pathIndex;
+  int i;
+  for (i=path.length()-1;i>=0 && node;i--)
+  {
+    node = node->child(path.at(i));
+  }
+  count = node ? node->count : 0;
+  return node ? node->last : 0;
 }
 
 
@@ -32,10 +32,20 @@ class FileName : public FileList
     const char *fullName() const { return fName; }
     void generateDiskNames();
 
+    /** Returns the last file in the list whose path, with the part
+     *  matching STRIP_FROM_INC_PATH removed, ends with \a path, or 0 if
+     *  there is none. \a count is set to the number of files that match.
+     */
+    FileDef *findByPath(const QCString &path,int &count);
+
   private:
+    struct PathNode;
     int compareValues(const FileDef *item1,const FileDef *item2) const;
+    void buildPathIndex();
     QCString name;
     QCString fName;
+    PathNode *m_pathIndex;
+    uint m_pathIndexCount;
 };
 
 /** Iterator for FileDef objects in a FileName list. */
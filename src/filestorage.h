@@ -15,121 +15,95 @@
 
 #include <qfile.h>
 #include <assert.h>
+#include <string.h>
 #include "store.h"
 
+#if !defined(_WIN32) || defined(__CYGWIN__)
+#define FILESTORAGE_USE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #ifndef FILESTORAGE_H
 #define FILESTORAGE_H
 
 /** @brief Store implementation based on a file. 
     Writing is linear, after that the file is re-opened for reading.
-    Reading is random (seek+read).
+    Reading is random (seek+read). Where available the file is mapped 
+    into memory when it is opened for reading, so reading only involves
+    copying bytes from the mapping instead of a system call per read.
  */
-class FileStorage : public StorageIntf
-{
-  public:
-    FileStorage() : m_readOnly(FALSE) {}
-    FileStorage( const QString &name) : 
-                    m_readOnly(FALSE)    { m_file.setName(name); }
-    int read(char *buf,uint size)        { return m_file.readBlock(buf,size); }
-    int write(const char *buf,uint size) { assert(m_readOnly==FALSE); return m_file.writeBlock(buf,size); }
-    bool open( int m )                   { m_readOnly = m==IO_ReadOnly; return m_file.open(m); }
-    bool seek(int64 pos)                 { return m_file.seek(pos); }
-    int64 pos() const                    { return m_file.pos(); }
-    void close()                         { m_file.close(); }
-    void setName( const char *name )     { m_file.setName(name); }
-  private:
-    bool m_readOnly;
-    QFile m_file;
-};
-
-#if 0 // experimental version using mmap after opening the file as read only.
-#include <sys/mman.h>
-#include <sys/stat.h>
-#include <fcntl.h>
-#include <string.h>
-#include <unistd.h>
-#include <stdio.h>
-
 class FileStorage : public StorageIntf
 {
   public:
     FileStorage() : m_readOnly(FALSE), m_map(0), m_off(0), m_size(0) {}
     FileStorage( const QString &name) : 
-                    m_readOnly(FALSE)    { m_file.setName(name); }
-    void setName( const char *name )     { m_file.setName(name); }
-    bool open( int m )                   
+                    m_readOnly(FALSE), m_map(0), m_off(0), m_size(0)
+                                         { m_file.setName(name); }
+   ~FileStorage()                        { close(); }
+    int read(char *buf,uint size)        
     { 
-      if (m==IO_ReadOnly)
+      if (m_map)
       {
-        m_readOnly=TRUE;
-        QString name = m_file.name();
-        m_file.close();
-        m_fd = ::open(name.data(),O_RDONLY);
-        struct stat stat;
-        fstat(m_fd,&stat);
-        m_size = stat.st_size;
-        m_map = mmap(NULL,m_size,PROT_READ,MAP_SHARED,m_fd,0);
-        if (m_map==MAP_FAILED) perror("mmap failed");
-        assert(m_map!=MAP_FAILED);
-        m_off = 0;
-        return TRUE;
-      }
-      else
-      {
-        m_readOnly = FALSE;
-        return m_file.open(m); 
+        if (m_off>=m_size) return 0;
+        if (m_off+size>m_size) size=(uint)(m_size-m_off);
+        memcpy(buf,m_map+m_off,size);
+        m_off+=size;
+        return size;
       }
+      return m_file.readBlock(buf,size); 
     }
-    int write(const char *buf,uint size) 
-    { 
-      assert(m_map==0);
-      return m_file.writeBlock(buf,size); 
-    }
-    int read(char *buf,uint size)        
+    int write(const char *buf,uint size) { assert(m_readOnly==FALSE); return m_file.writeBlock(buf,size); }
+    bool open( int m )                   
     { 
-      assert(m_map!=0);
-      memcpy(buf,((char *)m_map)+m_off,size); 
-      m_off+=size; 
-      return size; 
+      m_readOnly = m==IO_ReadOnly; 
+      if (!m_file.open(m)) return FALSE;
+#ifdef FILESTORAGE_USE_MMAP
+      struct stat st;
+      if (m_readOnly && fstat(m_file.handle(),&st)==0 && st.st_size>0)
+      {
+        void *map = mmap(0,st.st_size,PROT_READ,MAP_SHARED,m_file.handle(),0);
+        if (map!=MAP_FAILED) // otherwise fall back to reading the file
+        {
+          m_map  = (const char *)map;
+          m_size = st.st_size;
+          m_off  = 0;
+        }
+      }
+#endif
+      return TRUE;
     }
     bool seek(int64 pos)                 
     { 
-      m_off=pos; 
-      return TRUE; 
-    }
-    int64 pos() const                    
-    { 
-      if (m_readOnly)
+      if (m_map)
       {
-        return m_off; 
-      }
-      else
-      {
-        return m_file.pos();
+        if (pos<0 || pos>m_size) return FALSE;
+        m_off=pos;
+        return TRUE;
       }
+      return m_file.seek(pos); 
     }
+    int64 pos() const                    { return m_map ? m_off : m_file.pos(); }
     void close()                         
     { 
-      if (m_readOnly)
+#ifdef FILESTORAGE_USE_MMAP
+      if (m_map)
       {
-        munmap(m_map,m_size); 
-        ::close(m_fd);
-        exit(1);
-      }
-      else
-      {
-        m_file.close();
+        munmap((void *)m_map,m_size);
+        m_map=0;
+        m_off=0;
+        m_size=0;
       }
+#endif
+      m_file.close(); 
     }
+    void setName( const char *name )     { m_file.setName(name); }
   private:
     bool m_readOnly;
     QFile m_file;
-    int m_fd;
-    void *m_map;
-    off_t m_off;
-    off_t m_size;
+    const char *m_map;
+    int64 m_off;
+    int64 m_size;
 };
-#endif
 
 #endif
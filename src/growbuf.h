@@ -35,6 +35,11 @@ class GrowBuf
                           pos+=l;
                         }
                       }
+    void addArray(const char *s,int n) {
+                        if (pos+n>=len) { len+=n+GROW_AMOUNT; str = (char*)realloc(str,len); }
+                        memcpy(&str[pos],s,n);
+                        pos+=n;
+                      }
     const char *get()     { return str; }
     int getPos() const    { return pos; }
     char at(int i) const  { return str[i]; }
@@ -0,0 +1,205 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2015 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <qfileinfo.h>
+
+#include "inputreader.h"
+#include "bufstr.h"
+#include "util.h"
+#include "config.h"
+
+//--------------------------------------------------------------------
+
+// Note that the strings are deep copied, since QCString's reference
+// counting is not thread safe and the worker thread will use them.
+InputFileJob::InputFileJob(const char *fileName,const QCString &filterName,
+                           const QCString &inputEncoding,uint size)
+  : m_fileName(fileName), m_filterName(filterName.data()),
+    m_inputEncoding(inputEncoding.data()), m_buf(0), m_size(size), 
+    m_ok(FALSE), m_done(FALSE)
+{
+}
+
+InputFileJob::~InputFileJob()
+{
+  delete m_buf;
+}
+
+void InputFileJob::run()
+{
+  m_buf = new BufStr(m_size+4096);
+  readInputFileData(m_fileName,*m_buf,m_filterName,m_inputEncoding,m_status);
+}
+
+void InputFileJob::finish()
+{
+  m_ok = reportInputFileStatus(m_fileName,m_filterName,m_status,*m_buf);
+}
+
+//--------------------------------------------------------------------
+
+void InputFileQueue::enqueue(InputFileJob *job)
+{
+  QMutexLocker locker(&m_mutex);
+  m_queue.enqueue(job);
+  m_bufferNotEmpty.wakeAll();
+}
+
+InputFileJob *InputFileQueue::dequeue()
+{
+  QMutexLocker locker(&m_mutex);
+  while (m_queue.isEmpty())
+  {
+    // wait until something is added to the queue
+    m_bufferNotEmpty.wait(&m_mutex);
+  }
+  InputFileJob *result = m_queue.dequeue();
+  return result;
+}
+
+void InputFileQueue::jobDone(InputFileJob *job)
+{
+  QMutexLocker locker(&m_mutex);
+  job->m_done = TRUE;
+  m_jobDone.wakeAll();
+}
+
+void InputFileQueue::waitForJob(InputFileJob *job)
+{
+  QMutexLocker locker(&m_mutex);
+  while (!job->m_done)
+  {
+    m_jobDone.wait(&m_mutex);
+  }
+}
+
+//--------------------------------------------------------------------
+
+InputReaderThread::InputReaderThread(InputFileQueue *queue)
+      : m_queue(queue)
+{
+}
+
+void InputReaderThread::run()
+{
+  InputFileJob *job;
+  while ((job=m_queue->dequeue()))
+  {
+    job->run();
+    m_queue->jobDone(job);
+  }
+}
+
+//--------------------------------------------------------------------
+
+InputFileReader::InputFileReader(int numThreads)
+{
+  m_inputEncoding = Config_getString("INPUT_ENCODING");
+  if (numThreads==0) numThreads = QMAX(2,QThread::idealThreadCount());
+  numThreads = QMIN(32,numThreads);
+  int i;
+  for (i=0;i<numThreads;i++)
+  {
+    InputReaderThread *thread = new InputReaderThread(&m_queue);
+    thread->start();
+    if (thread->isRunning())
+    {
+      m_workers.append(thread);
+    }
+    else // no more threads available!
+    {
+      delete thread;
+    }
+  }
+  // limit the number of files and the amount of data that are kept in 
+  // memory ahead of the parser
+  m_maxScheduled = QMAX(1,m_workers.count())*4;
+  m_scheduledSize = 0;
+  m_maxScheduledSize = 64*1024*1024;
+  m_scheduled.setAutoDelete(TRUE);
+  m_workers.setAutoDelete(TRUE);
+}
+
+InputFileReader::~InputFileReader()
+{
+  uint i;
+  if (m_workers.count()==0) return;
+  // wait for the jobs that are still queued before deleting them
+  QListIterator<InputFileJob> it(m_scheduled);
+  InputFileJob *job;
+  for (;(job=it.current());++it)
+  {
+    m_queue.waitForJob(job);
+  }
+  // signal the workers we are done
+  for (i=0;i<m_workers.count();i++)
+  {
+    m_queue.enqueue(0); // add terminator for each worker
+  }
+  // wait for the workers to finish
+  for (i=0;i<m_workers.count();i++)
+  {
+    m_workers.at(i)->wait();
+  }
+}
+
+void InputFileReader::addFile(const char *fileName)
+{
+  m_pending.append(fileName);
+}
+
+void InputFileReader::scheduleJobs()
+{
+  while (m_scheduled.count()<m_maxScheduled && !m_pending.isEmpty())
+  {
+    QCString fileName = m_pending.getFirst();
+    QFileInfo fi(fileName);
+    uint size = fi.size();
+    if (!m_scheduled.isEmpty() && m_scheduledSize+size>m_maxScheduledSize)
+    {
+      // wait until the parser has taken the files ahead of this one
+      break;
+    }
+    m_pending.removeFirst();
+    InputFileJob *job = new InputFileJob(fileName,
+                              getFileFilter(fileName,FALSE),m_inputEncoding,size);
+    m_scheduled.append(job);
+    m_scheduledSize+=size;
+    if (m_workers.count()>0)
+    {
+      m_queue.enqueue(job);
+    }
+  }
+}
+
+InputFileJob *InputFileReader::takeNext()
+{
+  scheduleJobs();
+  if (m_scheduled.isEmpty()) return 0;
+  InputFileJob *job = m_scheduled.take(0);
+  m_scheduledSize-=job->size();
+  if (m_workers.count()>0)
+  {
+    m_queue.waitForJob(job);
+  }
+  else // no threads to work with
+  {
+    job->run();
+  }
+  job->finish();
+  // keep the workers busy while the caller processes this file
+  scheduleJobs();
+  return job;
+}
@@ -0,0 +1,129 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2015 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef INPUTREADER_H
+#define INPUTREADER_H
+
+#include <qlist.h>
+#include <qqueue.h>
+#include <qstrlist.h>
+#include <qthread.h>
+#include <qmutex.h>
+#include <qwaitcondition.h>
+
+#include "util.h"
+
+class BufStr;
+
+/** A single input file that is read (and filtered) ahead of the parser. */
+class InputFileJob
+{
+  public:
+    InputFileJob(const char *fileName,const QCString &filterName,
+                 const QCString &inputEncoding,uint size);
+   ~InputFileJob();
+
+    /** Reads the file into the buffer. Called from a worker thread,
+     *  so problems are only recorded here.
+     */
+    void run();
+
+    /** Reports the problems found by run(). Called from the main thread. */
+    void finish();
+
+    /** Returns the name of the file. */
+    QCString fileName() const { return m_fileName; }
+
+    /** Returns the (transcoded) contents of the file. */
+    BufStr *buffer() const { return m_buf; }
+
+    /** Returns TRUE if the file was read successfully. */
+    bool isOk() const { return m_ok; }
+
+    /** Returns the size of the file when it was scheduled. */
+    uint size() const { return m_size; }
+
+  private:
+    friend class InputFileQueue;
+    QCString m_fileName;
+    QCString m_filterName;
+    QCString m_inputEncoding;
+    BufStr  *m_buf;
+    InputFileStatus m_status;
+    uint     m_size;
+    bool     m_ok;
+    bool     m_done;
+};
+
+/** Queue of input files waiting to be read by a worker thread. */
+class InputFileQueue
+{
+  public:
+    void enqueue(InputFileJob *job);
+    InputFileJob *dequeue();
+    void jobDone(InputFileJob *job);
+    void waitForJob(InputFileJob *job);
+  private:
+    QWaitCondition  m_bufferNotEmpty;
+    QWaitCondition  m_jobDone;
+    QQueue<InputFileJob> m_queue;
+    mutable QMutex  m_mutex;
+};
+
+/** Worker thread reading input files. */
+class InputReaderThread : public QThread
+{
+  public:
+    InputReaderThread(InputFileQueue *queue);
+    void run();
+  private:
+    InputFileQueue *m_queue;
+};
+
+/** Reads the input files ahead of the parser using a number of
+ *  worker threads, while handing them to the parser in the order in
+ *  which they were added.
+ */
+class InputFileReader
+{
+  public:
+    InputFileReader(int numThreads);
+   ~InputFileReader();
+
+    /** Adds file \a fileName to the list of files to read. */
+    void addFile(const char *fileName);
+
+    /** Returns the next file in the order in which they were added,
+     *  waiting for it to be read if needed. The caller becomes the owner
+     *  of the returned job. Returns 0 if there are no more files.
+     */
+    InputFileJob *takeNext();
+
+    /** Returns the number of worker threads that are active. */
+    uint numThreads() const { return m_workers.count(); }
+
+  private:
+    void scheduleJobs();
+    InputFileQueue            m_queue;
+    QList<InputReaderThread>  m_workers;
+    QList<InputFileJob>       m_scheduled;
+    QStrList                  m_pending;
+    QCString                  m_inputEncoding;
+    uint                      m_maxScheduled;
+    uint                      m_scheduledSize;
+    uint                      m_maxScheduledSize;
+};
+
+#endif
@@ -0,0 +1,352 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2015 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <string.h>
+
+#include "lookupcache.h"
+#include "doxygen.h"
+#include "symbolmap.h"
+
+// Note that the strings are deep copied when they enter or leave the
+// cache, since QCString's reference counting is not thread safe.
+static inline QCString deepCopy(const QCString &s)
+{
+  return s.isEmpty() ? QCString() : QCString(s.data());
+}
+
+static inline uint hashString(uint h,const QCString &s)
+{
+  // FNV-1a, including the terminating 0 to separate the parts
+  const uchar *p=(const uchar *)s.data();
+  if (p)
+  {
+    while (*p) { h^=*p++; h*=16777619u; }
+  }
+  h*=16777619u;
+  return h;
+}
+
+LookupKey::LookupKey(const QCString &s,const QCString &n,
+                     const QCString &es,const QCString &fs)
+  : scope(s), name(n), explicitScope(es), fileScope(fs)
+{
+  hash = 2166136261u;
+  hash = hashString(hash,scope);
+  hash = hashString(hash,name);
+  hash = hashString(hash,explicitScope);
+  hash = hashString(hash,fileScope);
+}
+
+static inline bool sameKey(const LookupKey &k1,const LookupKey &k2)
+{
+  return k1.hash==k2.hash &&
+         qstrcmp(k1.name,k2.name)==0 &&
+         qstrcmp(k1.scope,k2.scope)==0 &&
+         qstrcmp(k1.explicitScope,k2.explicitScope)==0 &&
+         qstrcmp(k1.fileScope,k2.fileScope)==0;
+}
+
+//--------------------------------------------------------------------
+
+/** A cached result, which is part of a hash chain, the least recently used
+ *  list, and possibly one of the lists of results of the same kind.
+ */
+struct LookupCache::Entry
+{
+  Entry() // list head
+    : key(QCString(),QCString(),QCString(),QCString()),
+      next(0), lruPrev(0), lruNext(0), kindPrev(0), kindNext(0) {}
+  Entry(const LookupKey &k,const LookupInfo &i)
+    : key(deepCopy(k.scope),deepCopy(k.name),
+          deepCopy(k.explicitScope),deepCopy(k.fileScope)),
+      info(i.classDef,i.typeDef,deepCopy(i.templSpec),deepCopy(i.resolvedType)),
+      next(0), lruPrev(0), lruNext(0), kindPrev(0), kindNext(0) {}
+  LookupKey  key;
+  LookupInfo info;
+  Entry *next;                 // next entry in the same hash bucket
+  Entry *lruPrev, *lruNext;    // least recently used list
+  Entry *kindPrev,*kindNext;   // list of results of the same kind
+};
+
+/** Part of the cache with its own lock. */
+class LookupCache::Shard
+{
+  public:
+    enum Kind { Class, Unresolved, Other };
+
+    Shard(uint size)
+      : m_numBuckets(0), m_buckets(0), m_count(0), m_size(size),
+        m_replaced(0), m_hits(0), m_misses(0)
+    {
+      m_lru.lruPrev=m_lru.lruNext=&m_lru;
+      int k;
+      for (k=0;k<Other;k++) m_kinds[k].kindPrev=m_kinds[k].kindNext=&m_kinds[k];
+      resizeBuckets(16);
+    }
+   ~Shard()
+    {
+      clear();
+      delete[] m_buckets;
+    }
+
+    bool find(const LookupKey &key,LookupInfo &info)
+    {
+      QMutexLocker lock(&m_mutex);
+      Entry *e = *lookup(key);
+      if (e==0)
+      {
+        m_misses++;
+        return FALSE;
+      }
+      m_hits++;
+      // move to the front of the least recently used list
+      unlink(e,&Entry::lruPrev,&Entry::lruNext);
+      link(&m_lru,e,&Entry::lruPrev,&Entry::lruNext);
+      info.classDef     = e->info.classDef;
+      info.typeDef      = e->info.typeDef;
+      info.templSpec    = deepCopy(e->info.templSpec);
+      info.resolvedType = deepCopy(e->info.resolvedType);
+      return TRUE;
+    }
+
+    void insert(const LookupKey &key,const LookupInfo &info)
+    {
+      QMutexLocker lock(&m_mutex);
+      Entry **pe = lookup(key);
+      if (*pe) // replace the existing result
+      {
+        remove(pe);
+      }
+      else if (m_count>=m_size) // cache is full
+      {
+        m_replaced++;
+        if (m_replaced>=m_size && m_size<LookupCache::maxShardSize())
+        {
+          // all results have been replaced, so the cache is too small
+          m_size*=2;
+          m_replaced=0;
+        }
+        else
+        {
+          remove(lookup(m_lru.lruPrev->key));
+        }
+      }
+      Entry *e = new Entry(key,info);
+      if (m_count>=m_numBuckets)
+      {
+        resizeBuckets(m_numBuckets*2);
+      }
+      pe = &m_buckets[bucket(e->key.hash)];
+      e->next = *pe;
+      *pe = e;
+      link(&m_lru,e,&Entry::lruPrev,&Entry::lruNext);
+      Kind k = kind(e->info);
+      if (k!=Other) link(&m_kinds[k],e,&Entry::kindPrev,&Entry::kindNext);
+      m_count++;
+    }
+
+    void removeKind(Kind k)
+    {
+      QMutexLocker lock(&m_mutex);
+      while (m_kinds[k].kindNext!=&m_kinds[k])
+      {
+        remove(lookup(m_kinds[k].kindNext->key));
+      }
+    }
+
+    void clear()
+    {
+      QMutexLocker lock(&m_mutex);
+      while (m_lru.lruNext!=&m_lru)
+      {
+        remove(lookup(m_lru.lruNext->key));
+      }
+    }
+
+    uint count()  { QMutexLocker lock(&m_mutex); return m_count;  }
+    uint size()   { QMutexLocker lock(&m_mutex); return m_size;   }
+    uint hits()   { QMutexLocker lock(&m_mutex); return m_hits;   }
+    uint misses() { QMutexLocker lock(&m_mutex); return m_misses; }
+
+  private:
+    typedef Entry *Entry::*Link;
+
+    static Kind kind(const LookupInfo &info)
+    {
+      if (info.classDef) return Class;
+      if (info.typeDef==0) return Unresolved;
+      return Other;
+    }
+    static void link(Entry *head,Entry *e,Link prev,Link next)
+    {
+      e->*prev = head;
+      e->*next = head->*next;
+      (head->*next)->*prev = e;
+      head->*next = e;
+    }
+    static void unlink(Entry *e,Link prev,Link next)
+    {
+      (e->*prev)->*next = e->*next;
+      (e->*next)->*prev = e->*prev;
+      e->*prev = e->*next = 0;
+    }
+    uint bucket(uint hash) const
+    {
+      // the high bits of the hash select the shard
+      return hash&(m_numBuckets-1);
+    }
+    /** Returns the address of the pointer to the entry for \a key, or
+     *  of the pointer that ends the hash chain if there is no such entry.
+     */
+    Entry **lookup(const LookupKey &key)
+    {
+      Entry **pe = &m_buckets[bucket(key.hash)];
+      while (*pe && !sameKey((*pe)->key,key)) pe=&(*pe)->next;
+      return pe;
+    }
+    void remove(Entry **pe)
+    {
+      Entry *e = *pe;
+      *pe = e->next;
+      unlink(e,&Entry::lruPrev,&Entry::lruNext);
+      if (e->kindNext) unlink(e,&Entry::kindPrev,&Entry::kindNext);
+      delete e;
+      m_count--;
+    }
+    void resizeBuckets(uint numBuckets)
+    {
+      Entry **oldBuckets = m_buckets;
+      uint oldNumBuckets = m_numBuckets;
+      m_buckets = new Entry*[numBuckets];
+      memset(m_buckets,0,numBuckets*sizeof(Entry*));
+      m_numBuckets = numBuckets;
+      uint i;
+      for (i=0;i<oldNumBuckets;i++)
+      {
+        Entry *e = oldBuckets[i];
+        while (e)
+        {
+          Entry *next = e->next;
+          Entry **pe = &m_buckets[bucket(e->key.hash)];
+          e->next = *pe;
+          *pe = e;
+          e = next;
+        }
+      }
+      delete[] oldBuckets;
+    }
+
+    QMutex  m_mutex;
+    uint    m_numBuckets;  // always a power of two
+    Entry **m_buckets;
+    Entry   m_lru;           // head of the least recently used list
+    Entry   m_kinds[Other];  // heads of the lists per kind of result
+    uint    m_count;
+    uint    m_size;
+    uint    m_replaced;
+    uint    m_hits;
+    uint    m_misses;
+};
+
+//--------------------------------------------------------------------
+
+LookupCache::LookupCache(uint size)
+{
+  int i;
+  for (i=0;i<NumShards;i++)
+  {
+    m_shards[i] = new Shard(QMAX(1,size/NumShards));
+  }
+}
+
+/*! Returns the number of results a shard may grow to. This follows the
+ *  number of symbol names found so far, which are only added by the
+ *  main thread, so the cache grows with the size of the input.
+ */
+uint LookupCache::maxShardSize()
+{
+  uint numNames = Doxygen::symbolMap ? Doxygen::symbolMap->count() : 0;
+  uint maxSize = QMIN(numNames,(uint)MaxSize/ResultsPerName)*ResultsPerName;
+  return maxSize/NumShards;
+}
+
+LookupCache::~LookupCache()
+{
+  int i;
+  for (i=0;i<NumShards;i++)
+  {
+    delete m_shards[i];
+  }
+}
+
+bool LookupCache::find(const LookupKey &key,LookupInfo &info)
+{
+  return shard(key.hash)->find(key,info);
+}
+
+void LookupCache::insert(const LookupKey &key,const LookupInfo &info)
+{
+  shard(key.hash)->insert(key,info);
+}
+
+void LookupCache::removeClasses()
+{
+  int i;
+  for (i=0;i<NumShards;i++) m_shards[i]->removeKind(Shard::Class);
+}
+
+void LookupCache::removeUnresolved()
+{
+  int i;
+  for (i=0;i<NumShards;i++) m_shards[i]->removeKind(Shard::Unresolved);
+}
+
+void LookupCache::clear()
+{
+  int i;
+  for (i=0;i<NumShards;i++) m_shards[i]->clear();
+}
+
+uint LookupCache::count() const
+{
+  uint result=0;
+  int i;
+  for (i=0;i<NumShards;i++) result+=m_shards[i]->count();
+  return result;
+}
+
+uint LookupCache::size() const
+{
+  uint result=0;
+  int i;
+  for (i=0;i<NumShards;i++) result+=m_shards[i]->size();
+  return result;
+}
+
+uint LookupCache::hits() const
+{
+  uint result=0;
+  int i;
+  for (i=0;i<NumShards;i++) result+=m_shards[i]->hits();
+  return result;
+}
+
+uint LookupCache::misses() const
+{
+  uint result=0;
+  int i;
+  for (i=0;i<NumShards;i++) result+=m_shards[i]->misses();
+  return result;
+}
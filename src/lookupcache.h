@@ -0,0 +1,107 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2015 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef LOOKUPCACHE_H
+#define LOOKUPCACHE_H
+
+#include <qcstring.h>
+#include <qmutex.h>
+
+class ClassDef;
+class MemberDef;
+
+/** The result of resolving a class name in a given scope. */
+struct LookupInfo
+{
+  LookupInfo() : classDef(0), typeDef(0) {}
+  LookupInfo(ClassDef *cd,MemberDef *td,QCString ts,QCString rt)
+    : classDef(cd), typeDef(td), templSpec(ts),resolvedType(rt) {}
+  ClassDef  *classDef;
+  MemberDef *typeDef;
+  QCString   templSpec;
+  QCString   resolvedType;
+};
+
+/** The parts identifying a lookup: the name that is searched, the
+ *  scope in which it is searched, the explicit scope part given with the name,
+ *  and the file with using statements that can influence the result
+ *  (empty if there are none).
+ */
+struct LookupKey
+{
+  LookupKey(const QCString &s,const QCString &n,
+            const QCString &es,const QCString &fs);
+  QCString scope;
+  QCString name;
+  QCString explicitScope;
+  QCString fileScope;
+  uint     hash;
+};
+
+/** Cache for the results of resolving class names (see getResolvedClass()).
+ *
+ *  The cache is divided in a number of shards based on the hash of the key,
+ *  each with its own lock and least recently used list, so it can be used
+ *  from multiple threads. Results are copied in and out of the cache.
+ *
+ *  The cache starts with the size set by LOOKUP_CACHE_SIZE and doubles the
+ *  size of a shard once it has replaced as many results as it can hold,
+ *  as long as it holds less than ResultsPerName results for each symbol
+ *  name in Doxygen::symbolMap, and at most MaxSize results in total.
+ *
+ *  The results that are a class and the results that could not be resolved
+ *  are also kept in separate lists, so they can be removed without visiting
+ *  the other results.
+ */
+class LookupCache
+{
+  public:
+    enum { ResultsPerName = 8, MaxSize = 65536 << 9 };
+
+    LookupCache(uint size);
+   ~LookupCache();
+
+    /** Looks up \a key and copies the result to \a info. Returns FALSE
+     *  if there is no result for \a key.
+     */
+    bool find(const LookupKey &key,LookupInfo &info);
+
+    /** Stores \a info as the result for \a key. */
+    void insert(const LookupKey &key,const LookupInfo &info);
+
+    /** Removes the results that are a class. */
+    void removeClasses();
+
+    /** Removes the results without a class or typedef. */
+    void removeUnresolved();
+
+    /** Removes all results. */
+    void clear();
+
+    uint count() const;
+    uint size() const;
+    uint hits() const;
+    uint misses() const;
+
+  private:
+    struct Entry;
+    class Shard;
+    enum { NumShards = 16 };
+    static uint maxShardSize();
+    Shard *shard(uint hash) const { return m_shards[(hash>>24)%NumShards]; }
+    Shard *m_shards[NumShards];
+};
+
+#endif
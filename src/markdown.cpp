@@ -36,6 +36,7 @@
 #include <qregexp.h>
 #include <qfileinfo.h>
 #include <qdict.h>
+#include <qcache.h>
 
 #include "markdown.h"
 #include "growbuf.h"
@@ -94,6 +95,13 @@ static Entry         *g_current;
 static QCString       g_fileName;
 static int            g_lineNr;
 
+// Results of processMarkdown() for inputs whose conversion did not change
+// anything besides the output. The same comment text (license headers,
+// boilerplate documentation) is often converted many times.
+static QCache<QCString> g_markdownCache(8*1024*1024,1009);
+// TRUE if the current conversion added sections or changed the entry
+static bool           g_sideEffects;
+
 // In case a markdown page starts with a level1 header, that header is used
 // as a title of the page, in effect making it a level0 header, so the
 // level of all other sections needs to be corrected as well.
@@ -814,6 +822,7 @@ static int processLink(GrowBuf &out,const char *data,int,int size)
   if (isToc) // special case for [TOC]
   {
     if (g_current) g_current->stat=TRUE;
+    g_sideEffects=TRUE;
   }
   else if (isImageLink) 
   {
@@ -1708,6 +1717,7 @@ void writeOneLineHeaderOrRuler(GrowBuf &out,const char *data,int size)
       out.addStr(" ");
       out.addStr(header);
       out.addStr("\n");
+      g_sideEffects=TRUE;
       SectionInfo *si = Doxygen::sectionDict->find(id);
       if (si)
       {
@@ -2078,6 +2088,7 @@ static QCString processBlocks(const QCString &s,int indent)
             out.addStr(" ");
             out.addStr(header);
             out.addStr("\n\n");
+            g_sideEffects=TRUE;
             SectionInfo *si = Doxygen::sectionDict->find(id);
             if (si)
             {
@@ -2294,6 +2305,7 @@ QCString processMarkdown(const QCString &fileName,const int lineNr,Entry *e,cons
     g_actions[(unsigned int)'<']=processHtmlTag;
     g_actions[(unsigned int)'-']=processNmdash;
     g_actions[(unsigned int)'"']=processQuoted;
+    g_markdownCache.setAutoDelete(TRUE);
     init=TRUE;
   }
 
@@ -2304,6 +2316,12 @@ QCString processMarkdown(const QCString &fileName,const int lineNr,Entry *e,cons
   g_lineNr   = lineNr;
   static GrowBuf out;
   if (input.isEmpty()) return input;
+  QCString *cachedResult = g_markdownCache.find(input);
+  if (cachedResult)
+  {
+    return *cachedResult;
+  }
+  g_sideEffects = FALSE;
   out.clear();
   int refIndent;
   // for replace tabs by spaces
@@ -2319,7 +2337,16 @@ QCString processMarkdown(const QCString &fileName,const int lineNr,Entry *e,cons
   processInline(out,s,s.length());
   out.addChar(0);
   Debug::print(Debug::Markdown,0,"======== Markdown =========\n---- input ------- \n%s\n---- output -----\n%s\n---------\n",qPrint(input),qPrint(out.get()));
-  return out.get();
+  QCString result = out.get();
+  if (!g_sideEffects) // can be reused for the same input
+  {
+    QCString *newResult = new QCString(result);
+    if (!g_markdownCache.insert(input,newResult,input.length()+result.length()))
+    {
+      delete newResult; // too large to be cached
+    }
+  }
+  return result;
 }
 
 //---------------------------------------------------------------------------
@@ -344,61 +344,134 @@ void marshalMemberLists(StorageIntf *s,SDict<MemberList> *mls)
   }
 }
 
+// The fields of an entry as written by marshalEntry(). Entries
+// have many fields of which typically only a few are set, so the fields
+// are preceded by a mask with a bit for each field, and a field is only
+// written if it differs from the value it gets from Entry::reset().
+// The boolean fields are stored in the mask itself.
+enum EntryField
+{
+  EF_Name, EF_Type, EF_Protection, EF_MType, EF_Spec, EF_InitLines, EF_Stat,
+  EF_ExplicitExternal, EF_Proto, EF_SubGrouping, EF_CallGraph,
+  EF_CallerGraph, EF_Virt, EF_Args, EF_Bitfields, EF_ArgList, EF_TArgLists,
+  EF_Program, EF_Initializer, EF_IncludeFile, EF_IncludeName, EF_Doc,
+  EF_DocLine, EF_DocFile, EF_Brief, EF_BriefLine, EF_BriefFile,
+  EF_InbodyDocs, EF_InbodyLine, EF_InbodyFile, EF_Relates, EF_RelatesType,
+  EF_Read, EF_Write, EF_Inside, EF_Exception, EF_TypeConstr, EF_BodyLine,
+  EF_EndBodyLine, EF_MGrpId, EF_Extends, EF_Groups, EF_Anchors, EF_FileName,
+  EF_StartLine, EF_Sli, EF_Lang, EF_Hidden, EF_Artificial, EF_GroupDocType,
+  EF_Id
+};
+
+#define ENTRY_FIELD(f) (((uint64)1)<<(f))
+
+static bool isEmptyArgumentList(const ArgumentList *al)
+{
+  return al && al->count()==0 && !al->constSpecifier &&
+         !al->volatileSpecifier && !al->pureSpecifier &&
+         al->trailingReturnType.isEmpty();
+}
+
 void marshalEntry(StorageIntf *s,Entry *e)
 {
+  uint64 mask=0;
+  if (!e->name.isEmpty()) mask|=ENTRY_FIELD(EF_Name);
+  if (!e->type.isEmpty()) mask|=ENTRY_FIELD(EF_Type);
+  if (e->protection!=Public) mask|=ENTRY_FIELD(EF_Protection);
+  if (e->mtype!=Method) mask|=ENTRY_FIELD(EF_MType);
+  if (e->spec!=0) mask|=ENTRY_FIELD(EF_Spec);
+  if (e->initLines!=-1) mask|=ENTRY_FIELD(EF_InitLines);
+  if (e->stat) mask|=ENTRY_FIELD(EF_Stat);
+  if (e->explicitExternal) mask|=ENTRY_FIELD(EF_ExplicitExternal);
+  if (e->proto) mask|=ENTRY_FIELD(EF_Proto);
+  if (e->subGrouping) mask|=ENTRY_FIELD(EF_SubGrouping);
+  if (e->callGraph) mask|=ENTRY_FIELD(EF_CallGraph);
+  if (e->callerGraph) mask|=ENTRY_FIELD(EF_CallerGraph);
+  if (e->virt!=Normal) mask|=ENTRY_FIELD(EF_Virt);
+  if (!e->args.isEmpty()) mask|=ENTRY_FIELD(EF_Args);
+  if (!e->bitfields.isEmpty()) mask|=ENTRY_FIELD(EF_Bitfields);
+  if (!isEmptyArgumentList(e->argList)) mask|=ENTRY_FIELD(EF_ArgList);
+  if (e->tArgLists!=0) mask|=ENTRY_FIELD(EF_TArgLists);
+  if (!e->program.isEmpty()) mask|=ENTRY_FIELD(EF_Program);
+  if (!e->initializer.isEmpty()) mask|=ENTRY_FIELD(EF_Initializer);
+  if (!e->includeFile.isEmpty()) mask|=ENTRY_FIELD(EF_IncludeFile);
+  if (!e->includeName.isEmpty()) mask|=ENTRY_FIELD(EF_IncludeName);
+  if (!e->doc.isEmpty()) mask|=ENTRY_FIELD(EF_Doc);
+  if (e->docLine!=-1) mask|=ENTRY_FIELD(EF_DocLine);
+  if (!e->docFile.isEmpty()) mask|=ENTRY_FIELD(EF_DocFile);
+  if (!e->brief.isEmpty()) mask|=ENTRY_FIELD(EF_Brief);
+  if (e->briefLine!=-1) mask|=ENTRY_FIELD(EF_BriefLine);
+  if (!e->briefFile.isEmpty()) mask|=ENTRY_FIELD(EF_BriefFile);
+  if (!e->inbodyDocs.isEmpty()) mask|=ENTRY_FIELD(EF_InbodyDocs);
+  if (e->inbodyLine!=-1) mask|=ENTRY_FIELD(EF_InbodyLine);
+  if (!e->inbodyFile.isEmpty()) mask|=ENTRY_FIELD(EF_InbodyFile);
+  if (!e->relates.isEmpty()) mask|=ENTRY_FIELD(EF_Relates);
+  if (e->relatesType!=Simple) mask|=ENTRY_FIELD(EF_RelatesType);
+  if (!e->read.isEmpty()) mask|=ENTRY_FIELD(EF_Read);
+  if (!e->write.isEmpty()) mask|=ENTRY_FIELD(EF_Write);
+  if (!e->inside.isEmpty()) mask|=ENTRY_FIELD(EF_Inside);
+  if (!e->exception.isEmpty()) mask|=ENTRY_FIELD(EF_Exception);
+  if (e->typeConstr!=0) mask|=ENTRY_FIELD(EF_TypeConstr);
+  if (e->bodyLine!=-1) mask|=ENTRY_FIELD(EF_BodyLine);
+  if (e->endBodyLine!=-1) mask|=ENTRY_FIELD(EF_EndBodyLine);
+  if (e->mGrpId!=-1) mask|=ENTRY_FIELD(EF_MGrpId);
+  if (e->extends==0 || e->extends->count()>0) mask|=ENTRY_FIELD(EF_Extends);
+  if (e->groups==0 || e->groups->count()>0) mask|=ENTRY_FIELD(EF_Groups);
+  if (e->anchors==0 || e->anchors->count()>0) mask|=ENTRY_FIELD(EF_Anchors);
+  if (!e->fileName.isEmpty()) mask|=ENTRY_FIELD(EF_FileName);
+  if (e->startLine!=1) mask|=ENTRY_FIELD(EF_StartLine);
+  if (e->sli!=0) mask|=ENTRY_FIELD(EF_Sli);
+  if (e->lang!=SrcLangExt_Unknown) mask|=ENTRY_FIELD(EF_Lang);
+  if (e->hidden) mask|=ENTRY_FIELD(EF_Hidden);
+  if (e->artificial) mask|=ENTRY_FIELD(EF_Artificial);
+  if (e->groupDocType!=Entry::GROUPDOC_NORMAL) mask|=ENTRY_FIELD(EF_GroupDocType);
+  if (!e->id.isEmpty()) mask|=ENTRY_FIELD(EF_Id);
   marshalUInt(s,HEADER);
-  marshalQCString(s,e->name);
-  marshalQCString(s,e->type);
+  marshalUInt64(s,mask);
   marshalInt(s,e->section);
-  marshalInt(s,(int)e->protection);
-  marshalInt(s,(int)e->mtype);
-  marshalUInt64(s,e->spec);
-  marshalInt(s,e->initLines);
-  marshalBool(s,e->stat);
-  marshalBool(s,e->explicitExternal);
-  marshalBool(s,e->proto);
-  marshalBool(s,e->subGrouping);
-  marshalBool(s,e->callGraph);
-  marshalBool(s,e->callerGraph);
-  marshalInt(s,(int)e->virt);
-  marshalQCString(s,e->args);
-  marshalQCString(s,e->bitfields);
-  marshalArgumentList(s,e->argList);
-  marshalArgumentLists(s,e->tArgLists);
-  marshalQGString(s,e->program);
-  marshalQGString(s,e->initializer);
-  marshalQCString(s,e->includeFile);
-  marshalQCString(s,e->includeName);
-  marshalQCString(s,e->doc);
-  marshalInt(s,e->docLine);
-  marshalQCString(s,e->docFile);
-  marshalQCString(s,e->brief);
-  marshalInt(s,e->briefLine);
-  marshalQCString(s,e->briefFile);
-  marshalQCString(s,e->inbodyDocs);
-  marshalInt(s,e->inbodyLine);
-  marshalQCString(s,e->inbodyFile);
-  marshalQCString(s,e->relates);
-  marshalInt(s,e->relatesType);
-  marshalQCString(s,e->read);
-  marshalQCString(s,e->write);
-  marshalQCString(s,e->inside);
-  marshalQCString(s,e->exception);
-  marshalArgumentList(s,e->typeConstr);
-  marshalInt(s,e->bodyLine);
-  marshalInt(s,e->endBodyLine);
-  marshalInt(s,e->mGrpId);
-  marshalBaseInfoList(s,e->extends);
-  marshalGroupingList(s,e->groups);
-  marshalSectionInfoList(s,e->anchors);
-  marshalQCString(s,e->fileName);
-  marshalInt(s,e->startLine);
-  marshalItemInfoList(s,e->sli);
-  marshalInt(s,(int)e->lang);
-  marshalBool(s,e->hidden);
-  marshalBool(s,e->artificial);
-  marshalInt(s,(int)e->groupDocType);
-  marshalQCString(s,e->id);
+  if (mask&ENTRY_FIELD(EF_Name)) marshalQCString(s,e->name);
+  if (mask&ENTRY_FIELD(EF_Type)) marshalQCString(s,e->type);
+  if (mask&ENTRY_FIELD(EF_Protection)) marshalInt(s,(int)e->protection);
+  if (mask&ENTRY_FIELD(EF_MType)) marshalInt(s,(int)e->mtype);
+  if (mask&ENTRY_FIELD(EF_Spec)) marshalUInt64(s,e->spec);
+  if (mask&ENTRY_FIELD(EF_InitLines)) marshalInt(s,(int)e->initLines);
+  if (mask&ENTRY_FIELD(EF_Virt)) marshalInt(s,(int)e->virt);
+  if (mask&ENTRY_FIELD(EF_Args)) marshalQCString(s,e->args);
+  if (mask&ENTRY_FIELD(EF_Bitfields)) marshalQCString(s,e->bitfields);
+  if (mask&ENTRY_FIELD(EF_ArgList)) marshalArgumentList(s,e->argList);
+  if (mask&ENTRY_FIELD(EF_TArgLists)) marshalArgumentLists(s,e->tArgLists);
+  if (mask&ENTRY_FIELD(EF_Program)) marshalQGString(s,e->program);
+  if (mask&ENTRY_FIELD(EF_Initializer)) marshalQGString(s,e->initializer);
+  if (mask&ENTRY_FIELD(EF_IncludeFile)) marshalQCString(s,e->includeFile);
+  if (mask&ENTRY_FIELD(EF_IncludeName)) marshalQCString(s,e->includeName);
+  if (mask&ENTRY_FIELD(EF_Doc)) marshalQCString(s,e->doc);
+  if (mask&ENTRY_FIELD(EF_DocLine)) marshalInt(s,(int)e->docLine);
+  if (mask&ENTRY_FIELD(EF_DocFile)) marshalQCString(s,e->docFile);
+  if (mask&ENTRY_FIELD(EF_Brief)) marshalQCString(s,e->brief);
+  if (mask&ENTRY_FIELD(EF_BriefLine)) marshalInt(s,(int)e->briefLine);
+  if (mask&ENTRY_FIELD(EF_BriefFile)) marshalQCString(s,e->briefFile);
+  if (mask&ENTRY_FIELD(EF_InbodyDocs)) marshalQCString(s,e->inbodyDocs);
+  if (mask&ENTRY_FIELD(EF_InbodyLine)) marshalInt(s,(int)e->inbodyLine);
+  if (mask&ENTRY_FIELD(EF_InbodyFile)) marshalQCString(s,e->inbodyFile);
+  if (mask&ENTRY_FIELD(EF_Relates)) marshalQCString(s,e->relates);
+  if (mask&ENTRY_FIELD(EF_RelatesType)) marshalInt(s,(int)e->relatesType);
+  if (mask&ENTRY_FIELD(EF_Read)) marshalQCString(s,e->read);
+  if (mask&ENTRY_FIELD(EF_Write)) marshalQCString(s,e->write);
+  if (mask&ENTRY_FIELD(EF_Inside)) marshalQCString(s,e->inside);
+  if (mask&ENTRY_FIELD(EF_Exception)) marshalQCString(s,e->exception);
+  if (mask&ENTRY_FIELD(EF_TypeConstr)) marshalArgumentList(s,e->typeConstr);
+  if (mask&ENTRY_FIELD(EF_BodyLine)) marshalInt(s,(int)e->bodyLine);
+  if (mask&ENTRY_FIELD(EF_EndBodyLine)) marshalInt(s,(int)e->endBodyLine);
+  if (mask&ENTRY_FIELD(EF_MGrpId)) marshalInt(s,(int)e->mGrpId);
+  if (mask&ENTRY_FIELD(EF_Extends)) marshalBaseInfoList(s,e->extends);
+  if (mask&ENTRY_FIELD(EF_Groups)) marshalGroupingList(s,e->groups);
+  if (mask&ENTRY_FIELD(EF_Anchors)) marshalSectionInfoList(s,e->anchors);
+  if (mask&ENTRY_FIELD(EF_FileName)) marshalQCString(s,e->fileName);
+  if (mask&ENTRY_FIELD(EF_StartLine)) marshalInt(s,(int)e->startLine);
+  if (mask&ENTRY_FIELD(EF_Sli)) marshalItemInfoList(s,e->sli);
+  if (mask&ENTRY_FIELD(EF_Lang)) marshalInt(s,(int)e->lang);
+  if (mask&ENTRY_FIELD(EF_GroupDocType)) marshalInt(s,(int)e->groupDocType);
+  if (mask&ENTRY_FIELD(EF_Id)) marshalQCString(s,e->id);
 }
 
 void marshalEntryTree(StorageIntf *s,Entry *e)
@@ -729,62 +802,59 @@ Entry * unmarshalEntry(StorageIntf *s)
   Entry *e = new Entry;
   uint header=unmarshalUInt(s);
   ASSERT(header==HEADER);
-  e->name             = unmarshalQCString(s);
-  e->type             = unmarshalQCString(s);
-  e->section          = unmarshalInt(s);
-  e->protection       = (Protection)unmarshalInt(s);
-  e->mtype            = (MethodTypes)unmarshalInt(s);
-  e->spec             = unmarshalUInt64(s);
-  e->initLines        = unmarshalInt(s);
-  e->stat             = unmarshalBool(s);
-  e->explicitExternal = unmarshalBool(s);
-  e->proto            = unmarshalBool(s);
-  e->subGrouping      = unmarshalBool(s);
-  e->callGraph        = unmarshalBool(s);
-  e->callerGraph      = unmarshalBool(s);
-  e->virt             = (Specifier)unmarshalInt(s);
-  e->args             = unmarshalQCString(s);
-  e->bitfields        = unmarshalQCString(s);
-  delete e->argList;
-  e->argList          = unmarshalArgumentList(s);
-  e->tArgLists        = unmarshalArgumentLists(s);
-  e->program          = unmarshalQGString(s);
-  e->initializer      = unmarshalQGString(s);
-  e->includeFile      = unmarshalQCString(s);
-  e->includeName      = unmarshalQCString(s);
-  e->doc              = unmarshalQCString(s);
-  e->docLine          = unmarshalInt(s);
-  e->docFile          = unmarshalQCString(s);
-  e->brief            = unmarshalQCString(s);
-  e->briefLine        = unmarshalInt(s);
-  e->briefFile        = unmarshalQCString(s);
-  e->inbodyDocs       = unmarshalQCString(s);
-  e->inbodyLine       = unmarshalInt(s);
-  e->inbodyFile       = unmarshalQCString(s);
-  e->relates          = unmarshalQCString(s);
-  e->relatesType      = (RelatesType)unmarshalInt(s);
-  e->read             = unmarshalQCString(s);
-  e->write            = unmarshalQCString(s);
-  e->inside           = unmarshalQCString(s);
-  e->exception        = unmarshalQCString(s);
-  e->typeConstr       = unmarshalArgumentList(s);
-  e->bodyLine         = unmarshalInt(s);
-  e->endBodyLine      = unmarshalInt(s);
-  e->mGrpId           = unmarshalInt(s);
-  delete e->extends;
-  e->extends          = unmarshalBaseInfoList(s);
-  delete e->groups;
-  e->groups           = unmarshalGroupingList(s);
-  delete e->anchors;
-  e->anchors          = unmarshalSectionInfoList(s);
-  e->fileName         = unmarshalQCString(s);
-  e->startLine        = unmarshalInt(s);
-  e->sli              = unmarshalItemInfoList(s);
-  e->lang             = (SrcLangExt)unmarshalInt(s);
-  e->hidden           = unmarshalBool(s);
-  e->artificial       = unmarshalBool(s);
-  e->groupDocType     = (Entry::GroupDocType)unmarshalInt(s);
-  e->id               = unmarshalQCString(s);
+  uint64 mask = unmarshalUInt64(s);
+  e->section = unmarshalInt(s);
+  if (mask&ENTRY_FIELD(EF_Name)) e->name = unmarshalQCString(s);
+  if (mask&ENTRY_FIELD(EF_Type)) e->type = unmarshalQCString(s);
+  if (mask&ENTRY_FIELD(EF_Protection)) e->protection = (Protection)unmarshalInt(s);
+  if (mask&ENTRY_FIELD(EF_MType)) e->mtype = (MethodTypes)unmarshalInt(s);
+  if (mask&ENTRY_FIELD(EF_Spec)) e->spec = unmarshalUInt64(s);
+  if (mask&ENTRY_FIELD(EF_InitLines)) e->initLines = unmarshalInt(s);
+  if (mask&ENTRY_FIELD(EF_Virt)) e->virt = (Specifier)unmarshalInt(s);
+  if (mask&ENTRY_FIELD(EF_Args)) e->args = unmarshalQCString(s);
+  if (mask&ENTRY_FIELD(EF_Bitfields)) e->bitfields = unmarshalQCString(s);
+  if (mask&ENTRY_FIELD(EF_ArgList)) { delete e->argList; e->argList = unmarshalArgumentList(s); }
+  if (mask&ENTRY_FIELD(EF_TArgLists)) e->tArgLists = unmarshalArgumentLists(s);
+  if (mask&ENTRY_FIELD(EF_Program)) e->program = unmarshalQGString(s);
+  if (mask&ENTRY_FIELD(EF_Initializer)) e->initializer = unmarshalQGString(s);
+  if (mask&ENTRY_FIELD(EF_IncludeFile)) e->includeFile = unmarshalQCString(s);
+  if (mask&ENTRY_FIELD(EF_IncludeName)) e->includeName = unmarshalQCString(s);
+  if (mask&ENTRY_FIELD(EF_Doc)) e->doc = unmarshalQCString(s);
+  if (mask&ENTRY_FIELD(EF_DocLine)) e->docLine = unmarshalInt(s);
+  if (mask&ENTRY_FIELD(EF_DocFile)) e->docFile = unmarshalQCString(s);
+  if (mask&ENTRY_FIELD(EF_Brief)) e->brief = unmarshalQCString(s);
+  if (mask&ENTRY_FIELD(EF_BriefLine)) e->briefLine = unmarshalInt(s);
+  if (mask&ENTRY_FIELD(EF_BriefFile)) e->briefFile = unmarshalQCString(s);
+  if (mask&ENTRY_FIELD(EF_InbodyDocs)) e->inbodyDocs = unmarshalQCString(s);
+  if (mask&ENTRY_FIELD(EF_InbodyLine)) e->inbodyLine = unmarshalInt(s);
+  if (mask&ENTRY_FIELD(EF_InbodyFile)) e->inbodyFile = unmarshalQCString(s);
+  if (mask&ENTRY_FIELD(EF_Relates)) e->relates = unmarshalQCString(s);
+  if (mask&ENTRY_FIELD(EF_RelatesType)) e->relatesType = (RelatesType)unmarshalInt(s);
+  if (mask&ENTRY_FIELD(EF_Read)) e->read = unmarshalQCString(s);
+  if (mask&ENTRY_FIELD(EF_Write)) e->write = unmarshalQCString(s);
+  if (mask&ENTRY_FIELD(EF_Inside)) e->inside = unmarshalQCString(s);
+  if (mask&ENTRY_FIELD(EF_Exception)) e->exception = unmarshalQCString(s);
+  if (mask&ENTRY_FIELD(EF_TypeConstr)) e->typeConstr = unmarshalArgumentList(s);
+  if (mask&ENTRY_FIELD(EF_BodyLine)) e->bodyLine = unmarshalInt(s);
+  if (mask&ENTRY_FIELD(EF_EndBodyLine)) e->endBodyLine = unmarshalInt(s);
+  if (mask&ENTRY_FIELD(EF_MGrpId)) e->mGrpId = unmarshalInt(s);
+  if (mask&ENTRY_FIELD(EF_Extends)) { delete e->extends; e->extends = unmarshalBaseInfoList(s); }
+  if (mask&ENTRY_FIELD(EF_Groups)) { delete e->groups; e->groups = unmarshalGroupingList(s); }
+  if (mask&ENTRY_FIELD(EF_Anchors)) { delete e->anchors; e->anchors = unmarshalSectionInfoList(s); }
+  if (mask&ENTRY_FIELD(EF_FileName)) e->fileName = unmarshalQCString(s);
+  if (mask&ENTRY_FIELD(EF_StartLine)) e->startLine = unmarshalInt(s);
+  if (mask&ENTRY_FIELD(EF_Sli)) e->sli = unmarshalItemInfoList(s);
+  if (mask&ENTRY_FIELD(EF_Lang)) e->lang = (SrcLangExt)unmarshalInt(s);
+  if (mask&ENTRY_FIELD(EF_GroupDocType)) e->groupDocType = (Entry::GroupDocType)unmarshalInt(s);
+  if (mask&ENTRY_FIELD(EF_Id)) e->id = unmarshalQCString(s);
+  e->stat = (mask&ENTRY_FIELD(EF_Stat))!=0;
+  e->explicitExternal = (mask&ENTRY_FIELD(EF_ExplicitExternal))!=0;
+  e->proto = (mask&ENTRY_FIELD(EF_Proto))!=0;
+  e->subGrouping = (mask&ENTRY_FIELD(EF_SubGrouping))!=0;
+  e->callGraph = (mask&ENTRY_FIELD(EF_CallGraph))!=0;
+  e->callerGraph = (mask&ENTRY_FIELD(EF_CallerGraph))!=0;
+  e->hidden = (mask&ENTRY_FIELD(EF_Hidden))!=0;
+  e->artificial = (mask&ENTRY_FIELD(EF_Artificial))!=0;
   return e;
 }
 
@@ -44,6 +44,7 @@
 #include "namespacedef.h"
 #include "filedef.h"
 #include "config.h"
+#include "stringpool.h"
 
 //-----------------------------------------------------------------------------
 
@@ -636,9 +637,9 @@ void MemberDefImpl::init(Definition *def,
   //  type.stripPrefix("struct ");
   //  type.stripPrefix("class " );
   //  type.stripPrefix("union " );
-  type=removeRedundantWhiteSpace(type);
+  type=StringPool::intern(removeRedundantWhiteSpace(type));
   args=a;
-  args=removeRedundantWhiteSpace(args);
+  args=StringPool::intern(removeRedundantWhiteSpace(args));
   if (type.isEmpty()) decl=def->name()+args; else decl=type+" "+def->name()+args;
 
   memberGroup=0;
@@ -3888,7 +3889,7 @@ void MemberDef::setTypeConstraints(ArgumentList *al)
 
 void MemberDef::setType(const char *t)
 {
-  m_impl->type = t;
+  m_impl->type = StringPool::intern(t);
 }
 
 void MemberDef::setAccessorType(ClassDef *cd,const char *t)
@@ -4689,7 +4690,7 @@ void MemberDef::setInheritsDocsFrom(MemberDef *md)
 
 void MemberDef::setArgsString(const char *as)
 {
-  m_impl->args = as;
+  m_impl->args = StringPool::intern(as);
 }
 
 void MemberDef::setRelatedAlso(ClassDef *cd)
@@ -34,6 +34,7 @@ static const char *error_str = "error: ";
 //                            // 6 = $line,$file,$text
 
 static FILE *warnFile = stderr;
+static int warnCount = 0; // including the warnings that are disabled
 
 void initWarningFormat()
 {
@@ -151,6 +152,7 @@ static void format_warn(const char *file,int line,const char *text)
 
 static void do_warn(const char *tag, const char *file, int line, const char *prefix, const char *fmt, va_list args)
 {
+  warnCount++;
   if (tag && !Config_getBool(tag)) return; // warning type disabled
   const int bufSize = 40960;
   char text[bufSize];
@@ -180,6 +182,7 @@ void va_warn(const char *file,int line,const char *fmt,va_list args)
 
 void warn_simple(const char *file,int line,const char *text)
 {
+  warnCount++;
   if (!Config_getBool("WARNINGS")) return; // warning type disabled
   format_warn(file,line,QCString(warning_str) + text);
 }
@@ -250,3 +253,8 @@ void printlex(int dbg, bool enter, const char *lexName, const char *fileName)
       Debug::print(Debug::Lex,0,"%s lexical analyzer: %s\n",enter_txt_uc, qPrint(lexName));
   }
 }
+
+int warningCount()
+{
+  return warnCount;
+}
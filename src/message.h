@@ -31,6 +31,7 @@ extern void warn_uncond(const char *fmt, ...);
 extern void err(const char *fmt, ...);
 extern void err_full(const char *file,int line,const char *fmt, ...);
 void initWarningFormat();
+int warningCount();
 
 extern void printlex(int dbg, bool enter, const char *lexName, const char *fileName);
 #endif
@@ -0,0 +1,181 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2015 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef OBJPOOL_H
+#define OBJPOOL_H
+
+#include <stdlib.h>
+#include <new>
+#include <qglobal.h>
+
+/** Memory for objects of a fixed size that are created and destroyed in
+ *  large numbers. Objects are carved out of large blocks and freed objects
+ *  are put on a free list to be reused for new ones, so the memory of the
+ *  objects of one file is reused for the next file. The blocks are kept
+ *  until trim() is called. The pool is not locked, so it may only be used
+ *  from the main thread.
+ */
+class ObjPool
+{
+  public:
+    ObjPool(uint objSize)
+      : m_objSize((objSize+sizeof(double)-1)/sizeof(double)*sizeof(double)),
+        m_freeList(0), m_blocks(0), m_blockPos(0), m_blockEnd(0),
+        m_numBlocks(0), m_count(0), m_numAllocated(0) {}
+    void *alloc()
+    {
+      if (m_freeList) // reuse a freed object
+      {
+        FreeObj *o = m_freeList;
+        m_freeList = o->next;
+        m_count++;
+        m_numAllocated++;
+        return o;
+      }
+      if (m_blockPos==m_blockEnd) // start a new block
+      {
+        Block *b = (Block *)malloc(blockHeaderSize+objsPerBlock*m_objSize);
+        if (b==0) throw std::bad_alloc();
+        b->next  = m_blocks;
+        m_blocks = b;
+        m_numBlocks++;
+        m_blockPos = (char *)b+blockHeaderSize;
+        m_blockEnd = m_blockPos+objsPerBlock*m_objSize;
+      }
+      void *result = m_blockPos;
+      m_blockPos+=m_objSize;
+      m_count++;
+      m_numAllocated++;
+      return result;
+    }
+    void free(void *p)
+    {
+      FreeObj *o = (FreeObj *)p;
+      o->next = m_freeList;
+      m_freeList = o;
+      m_count--;
+    }
+    /** Releases the blocks that hold no objects. */
+    void trim()
+    {
+      if (m_count==0) // all free, nothing to sort out
+      {
+        while (m_blocks)
+        {
+          Block *b = m_blocks;
+          m_blocks = b->next;
+          ::free(b);
+        }
+        m_freeList = 0;
+        m_blockPos = 0;
+        m_blockEnd = 0;
+        m_numBlocks = 0;
+        return;
+      }
+      // sort the blocks by address, so the block of a free object can be found
+      BlockInfo *info = (BlockInfo *)malloc(m_numBlocks*sizeof(BlockInfo));
+      if (info==0) return; // keep the blocks
+      uint i=0;
+      Block *b;
+      for (b=m_blocks;b;b=b->next,i++)
+      {
+        info[i].block = b;
+        info[i].numFree = 0;
+      }
+      qsort(info,m_numBlocks,sizeof(BlockInfo),compareBlocks);
+      FreeObj *o;
+      for (o=m_freeList;o;o=o->next)
+      {
+        findBlock(info,o)->numFree++;
+      }
+      if (m_blockPos!=m_blockEnd) // the unused part of the current block is free too
+      {
+        findBlock(info,m_blockPos)->numFree+=(m_blockEnd-m_blockPos)/m_objSize;
+      }
+      // keep the free objects of the blocks that are still in use
+      FreeObj *freeList = 0;
+      for (o=m_freeList;o;)
+      {
+        FreeObj *next = o->next;
+        if (findBlock(info,o)->numFree!=objsPerBlock)
+        {
+          o->next = freeList;
+          freeList = o;
+        }
+        o = next;
+      }
+      m_freeList = freeList;
+      if (m_blockPos!=m_blockEnd && findBlock(info,m_blockPos)->numFree==objsPerBlock)
+      {
+        m_blockPos = 0;
+        m_blockEnd = 0;
+      }
+      // release the blocks without objects
+      uint numBlocks = m_numBlocks;
+      m_blocks = 0;
+      m_numBlocks = 0;
+      for (i=0;i<numBlocks;i++)
+      {
+        if (info[i].numFree==objsPerBlock)
+        {
+          ::free(info[i].block);
+        }
+        else
+        {
+          info[i].block->next = m_blocks;
+          m_blocks = info[i].block;
+          m_numBlocks++;
+        }
+      }
+      ::free(info);
+    }
+    /** Returns the number of objects allocated so far. */
+    uint64 numAllocated() const { return m_numAllocated; }
+  private:
+    struct FreeObj { FreeObj *next; };
+    struct Block { Block *next; };
+    struct BlockInfo { Block *block; uint numFree; };
+    enum { objsPerBlock = 256,
+           // keep the objects aligned like malloc does
+           blockHeaderSize = (sizeof(Block)+sizeof(double)-1)/sizeof(double)*sizeof(double)
+         };
+    static int compareBlocks(const void *p1,const void *p2)
+    {
+      const Block *b1 = ((const BlockInfo *)p1)->block;
+      const Block *b2 = ((const BlockInfo *)p2)->block;
+      return b1<b2 ? -1 : b1>b2 ? 1 : 0;
+    }
+    /** Returns the block that holds the object at \a p. */
+    BlockInfo *findBlock(BlockInfo *info,void *p) const
+    {
+      uint l=0,r=m_numBlocks;
+      while (r-l>1)
+      {
+        uint m=(l+r)/2;
+        if ((char *)info[m].block<=(char *)p) l=m; else r=m;
+      }
+      return &info[l];
+    }
+    uint m_objSize;
+    FreeObj *m_freeList;
+    Block *m_blocks;
+    char *m_blockPos;
+    char *m_blockEnd;
+    uint m_numBlocks;
+    uint m_count;
+    uint64 m_numAllocated;
+};
+
+#endif
@@ -18,8 +18,10 @@
 #include <stdlib.h>
 
 #include <qfile.h>
+#include <qbuffer.h>
 
 #include "outputgen.h"
+#include "outputwriter.h"
 #include "message.h"
 #include "portable.h"
 
@@ -27,6 +29,7 @@ OutputGenerator::OutputGenerator()
 {
   //printf("OutputGenerator::OutputGenerator()\n");
   file=0;
+  buffer=0;
   active=TRUE;
   genStack = new QStack<bool>;
   genStack->setAutoDelete(TRUE);
@@ -36,6 +39,7 @@ OutputGenerator::~OutputGenerator()
 {
   //printf("OutputGenerator::~OutputGenerator()\n");
   delete file;
+  delete buffer;
   delete genStack;
 }
 
@@ -43,6 +47,15 @@ void OutputGenerator::startPlainFile(const char *name)
 {
   //printf("startPlainFile(%s)\n",name);
   fileName=dir+"/"+name;
+  if (OutputFileWriter::instance()->isActive())
+  {
+    // collect the contents in memory and let the output file writer
+    // decide when and if it needs to be written
+    buffer = new QBuffer;
+    buffer->open(IO_WriteOnly);
+    t.setDevice(buffer);
+    return;
+  }
   file = new QFile(fileName);
   if (!file)
   {
@@ -60,6 +73,12 @@ void OutputGenerator::startPlainFile(const char *name)
 void OutputGenerator::endPlainFile()
 {
   t.unsetDevice();
+  if (buffer)
+  {
+    buffer->close();
+    OutputFileWriter::instance()->write(fileName,buffer);
+    buffer=0;
+  }
   delete file;
   file=0;
   fileName.resize(0);
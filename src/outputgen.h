@@ -36,6 +36,7 @@ class MemberDef;
 class GroupDef;
 class Definition;
 class QFile;
+class QBuffer;
 
 struct DocLinkInfo
 {
@@ -485,6 +486,7 @@ class OutputGenerator : public BaseOutputDocInterface
   protected:
     FTextStream t;
     QFile *file;
+    QBuffer *buffer;
     QCString fileName;
     QCString dir;
     bool active;
@@ -0,0 +1,382 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2015 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <stdio.h>
+
+#include <qbuffer.h>
+#include <qdict.h>
+#include <qfile.h>
+#include <qtextstream.h>
+
+#include "outputwriter.h"
+#include "message.h"
+#include "config.h"
+#include "ftextstream.h"
+#include "md5.h"
+
+//--------------------------------------------------------------------
+
+/** Signature recorded in the manifest for pages that are always written,
+ *  so they are still removed when a later run does not write them.
+ */
+static const char alwaysWrittenSig[] = "-";
+
+// Note that the file name is deep copied and the contents are only
+// accessed by the worker thread, since QCString's and QByteArray's
+// reference counting is not thread safe. For the same reason the worker
+// thread only uses stdio on the plain file name, and leaves reporting 
+// problems to the main thread.
+OutputFileJob::OutputFileJob(const char *fileName,QBuffer *contents,
+                             bool mayKeep)
+  : m_fileName(fileName), m_contents(contents), m_mayKeep(mayKeep)
+{
+}
+
+OutputFileJob::~OutputFileJob()
+{
+  delete m_contents;
+}
+
+OutputFileJob::Status OutputFileJob::run(OutputFileWriter *writer)
+{
+  uint size = m_contents->size();
+  QCString sigStr;
+  if (m_mayKeep)
+  {
+    uchar md5_sig[16];
+    sigStr.resize(33);
+    MD5Buffer((const unsigned char *)m_contents->buffer().data(),size,md5_sig);
+    MD5SigToString(md5_sig,sigStr.rawData(),33);
+    if (writer->isUnchanged(m_fileName,sigStr))
+    {
+      return Ok; // keep the file as it is
+    }
+  }
+  Status status = Ok;
+  FILE *f = fopen(m_fileName,"wb");
+  if (f==0)
+  {
+    status = OpenFailed;
+  }
+  else
+  {
+    if (size>0 && fwrite(m_contents->buffer().data(),1,size,f)!=size)
+    {
+      status = WriteFailed;
+    }
+    if (fclose(f)!=0)
+    {
+      status = WriteFailed;
+    }
+  }
+  if (writer->useSignatures())
+  {
+    // forget the checksum of a file that could not be written, and
+    // record a file that is changed afterwards as always written
+    writer->setSignature(m_fileName,status!=Ok ? 0 :
+                                    m_mayKeep  ? sigStr.data() :
+                                                 alwaysWrittenSig);
+  }
+  return status;
+}
+
+//--------------------------------------------------------------------
+
+void OutputFileQueue::enqueue(OutputFileJob *job)
+{
+  QMutexLocker locker(&m_mutex);
+  m_queue.enqueue(job);
+  m_bufferNotEmpty.wakeAll();
+}
+
+OutputFileJob *OutputFileQueue::dequeue()
+{
+  QMutexLocker locker(&m_mutex);
+  while (m_queue.isEmpty())
+  {
+    // wait until something is added to the queue
+    m_bufferNotEmpty.wait(&m_mutex);
+  }
+  OutputFileJob *result = m_queue.dequeue();
+  return result;
+}
+
+//--------------------------------------------------------------------
+
+OutputWriterThread::OutputWriterThread(OutputFileWriter *writer)
+      : m_writer(writer)
+{
+}
+
+void OutputWriterThread::run()
+{
+  OutputFileJob *job;
+  while ((job=m_queue.dequeue()))
+  {
+    OutputFileJob::Status status = job->run(m_writer);
+    m_writer->jobDone(job->fileName(),status);
+    delete job;
+  }
+}
+
+//--------------------------------------------------------------------
+
+OutputFileWriter *OutputFileWriter::m_theInstance = 0;
+
+OutputFileWriter *OutputFileWriter::instance()
+{
+  if (!m_theInstance)
+  {
+    m_theInstance = new OutputFileWriter;
+  }
+  return m_theInstance;
+}
+
+OutputFileWriter::OutputFileWriter() 
+  : m_numPending(0), m_ok(TRUE), m_signatures(10007), m_written(10007)
+{
+  m_failed.setAutoDelete(TRUE);
+  m_workers.setAutoDelete(TRUE);
+  m_signatures.setAutoDelete(TRUE);
+  m_useSignatures = Config_getBool("SKIP_UNCHANGED_PAGES");
+  if (m_useSignatures)
+  {
+    m_manifestName = Config_getString("OUTPUT_DIRECTORY")+"/doxygen_pages.md5";
+    if (Config_getBool("GENERATE_RTF"))
+    {
+      m_rtfDir = Config_getString("RTF_OUTPUT")+"/";
+    }
+    readManifest();
+  }
+  int numThreads = QMIN(32,Config_getInt("NUM_OUTPUT_THREADS"));
+  if (numThreads!=1)
+  {
+    if (numThreads==0) numThreads = QMAX(2,QThread::idealThreadCount());
+    int i;
+    for (i=0;i<numThreads;i++)
+    {
+      OutputWriterThread *thread = new OutputWriterThread(this);
+      thread->start();
+      if (thread->isRunning())
+      {
+        m_workers.append(thread);
+      }
+      else // no more threads available!
+      {
+        delete thread;
+      }
+    }
+  }
+  // limit the number of pages that are kept in memory
+  m_maxPending = m_workers.count()*16;
+}
+
+OutputFileWriter::~OutputFileWriter()
+{
+  finish();
+}
+
+void OutputFileWriter::write(const char *fileName,QBuffer *contents)
+{
+  ASSERT(isActive());
+  if (m_workers.count()==0) // no threads to work with
+  {
+    OutputFileJob job(fileName,contents,
+                      m_useSignatures && !isPostProcessed(fileName,contents));
+    jobDone(job.fileName(),job.run(this));
+    reportFailures();
+    return;
+  }
+  {
+    QMutexLocker locker(&m_mutex);
+    while (m_numPending>=m_maxPending)
+    {
+      // wait until the workers catch up
+      m_jobDone.wait(&m_mutex);
+    }
+    m_numPending++;
+  }
+  // select the worker based on the file name
+  uint h=0;
+  const char *p=fileName;
+  while (*p) h=(h<<5)+h+(uchar)*p++;
+  m_workers.at(h%m_workers.count())->queue()->enqueue(
+      new OutputFileJob(fileName,contents,
+                        m_useSignatures && !isPostProcessed(fileName,contents)));
+}
+
+void OutputFileWriter::jobDone(const char *fileName,OutputFileJob::Status status)
+{
+  QMutexLocker locker(&m_mutex);
+  if (status!=OutputFileJob::Ok)
+  {
+    m_failed.append(new OutputFileError(fileName,status));
+    m_ok=FALSE;
+  }
+  if (m_workers.count()>0) m_numPending--;
+  m_jobDone.wakeAll();
+}
+
+void OutputFileWriter::reportFailures()
+{
+  QMutexLocker locker(&m_mutex);
+  QListIterator<OutputFileError> it(m_failed);
+  OutputFileError *e;
+  for (;(e=it.current());++it)
+  {
+    if (e->status==OutputFileJob::OpenFailed)
+    {
+      err("Could not open file %s for writing\n",e->fileName.data());
+    }
+    else
+    {
+      err("problems while writing file %s\n",e->fileName.data());
+    }
+  }
+  m_failed.clear();
+}
+
+/*! Returns TRUE if file \a fileName with contents \a contents is
+ *  changed after it has been written, so its contents cannot be used to
+ *  decide whether the file on disk is up to date.
+ */
+bool OutputFileWriter::isPostProcessed(const char *fileName,QBuffer *contents) const
+{
+  // the RTF pages are merged into refman.rtf
+  if (!m_rtfDir.isEmpty() && qstrncmp(fileName,m_rtfDir,m_rtfDir.length())==0)
+  {
+    return TRUE;
+  }
+  // the markers are replaced by the graphs generated by the DotManager
+  static const char *markers[] = { "<!-- MAP", "<!-- SVG", "[!-- SVG", "% FIG", 0 };
+  QByteArray buf = contents->buffer();
+  const char *p = buf.data();
+  const char *e = p+buf.size();
+  for (;p<e;p++)
+  {
+    if (*p=='<' || *p=='[' || *p=='%')
+    {
+      const char **m;
+      for (m=markers;*m;m++)
+      {
+        int l=qstrlen(*m);
+        if (e-p>=l && qstrncmp(p,*m,l)==0) return TRUE;
+      }
+    }
+  }
+  return FALSE;
+}
+
+bool OutputFileWriter::isUnchanged(const char *fileName,const char *sig)
+{
+  bool sameSig;
+  {
+    QMutexLocker locker(&m_mutex);
+    m_written.replace(fileName,(void*)0x8);
+    QCString *oldSig = m_signatures.find(fileName);
+    sameSig = oldSig && qstrcmp(*oldSig,sig)==0;
+  }
+  struct stat st;
+  return sameSig && stat(fileName,&st)==0;
+}
+
+void OutputFileWriter::setSignature(const char *fileName,const char *sig)
+{
+  QMutexLocker locker(&m_mutex);
+  m_written.replace(fileName,(void*)0x8);
+  if (sig==0)
+  {
+    m_signatures.remove(fileName);
+  }
+  else
+  {
+    m_signatures.replace(fileName,new QCString(sig));
+  }
+}
+
+void OutputFileWriter::readManifest()
+{
+  QFile f(m_manifestName);
+  if (f.open(IO_ReadOnly))
+  {
+    // the names are read back as the bytes written by writeManifest()
+    QTextStream t(&f);
+    t.setEncoding(QTextStream::Latin1);
+    while (!t.eof())
+    {
+      // each line has the form: <md5 checksum> <file name>
+      QCString line = t.readLine().latin1();
+      int se = line.find(' ');
+      if (se==-1) break;
+      m_signatures.insert(line.mid(se+1),new QCString(line.left(se)));
+    }
+  }
+}
+
+void OutputFileWriter::writeManifest()
+{
+  // remove the pages of the previous run that were not written by this run
+  QAsciiDictIterator<QCString> it(m_signatures);
+  for (;it.current();++it)
+  {
+    QCString fileName = it.currentKey();
+    if (m_written.find(fileName)==0 && remove(fileName)==0)
+    {
+      msg("Removing stale page %s\n",fileName.data());
+    }
+  }
+  QFile f(m_manifestName);
+  if (!f.open(IO_WriteOnly))
+  {
+    err("Could not open file %s for writing\n",m_manifestName.data());
+    return;
+  }
+  FTextStream t(&f);
+  for (it.toFirst();it.current();++it)
+  {
+    QCString fileName = it.currentKey();
+    if (m_written.find(fileName))
+    {
+      t << *it.current() << " " << fileName << endl;
+    }
+  }
+}
+
+bool OutputFileWriter::finish()
+{
+  if (!isActive()) return m_ok;
+  uint i;
+  // signal the workers we are done, since each worker has its own queue,
+  // this will only happen after all pending files are written.
+  for (i=0;i<m_workers.count();i++)
+  {
+    m_workers.at(i)->queue()->enqueue(0);
+  }
+  // wait for the workers to finish
+  for (i=0;i<m_workers.count();i++)
+  {
+    m_workers.at(i)->wait();
+  }
+  m_workers.clear();
+  reportFailures();
+  if (m_useSignatures)
+  {
+    writeManifest();
+    m_useSignatures=FALSE;
+  }
+  return m_ok;
+}
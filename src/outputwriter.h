@@ -0,0 +1,154 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2015 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef OUTPUTWRITER_H
+#define OUTPUTWRITER_H
+
+#include <qlist.h>
+#include <qqueue.h>
+#include <qasciidict.h>
+#include <qcstring.h>
+#include <qthread.h>
+#include <qmutex.h>
+#include <qwaitcondition.h>
+
+class QBuffer;
+class OutputFileWriter;
+
+/** The contents of an output file waiting to be written to disk. */
+class OutputFileJob
+{
+  public:
+    OutputFileJob(const char *fileName,QBuffer *contents,bool mayKeep);
+   ~OutputFileJob();
+
+    enum Status { Ok, OpenFailed, WriteFailed };
+
+    /** Writes the contents to the file, unless \a writer knows the
+     *  file has the same contents already. Called from a worker thread,
+     *  so problems are only returned here.
+     */
+    Status run(OutputFileWriter *writer);
+
+    /** Returns the name of the file. */
+    const char *fileName() const { return m_fileName; }
+
+  private:
+    QCString m_fileName;
+    QBuffer *m_contents;
+    bool     m_mayKeep;
+};
+
+/** An output file that could not be written, waiting to be reported. */
+struct OutputFileError
+{
+  OutputFileError(const char *f,OutputFileJob::Status s) 
+    : fileName(f), status(s) {}
+  QCString fileName;
+  OutputFileJob::Status status;
+};
+
+/** Queue of output files waiting to be written by a worker thread. */
+class OutputFileQueue
+{
+  public:
+    void enqueue(OutputFileJob *job);
+    OutputFileJob *dequeue();
+  private:
+    QWaitCondition  m_bufferNotEmpty;
+    QQueue<OutputFileJob> m_queue;
+    mutable QMutex  m_mutex;
+};
+
+/** Worker thread writing output files. */
+class OutputWriterThread : public QThread
+{
+  public:
+    OutputWriterThread(OutputFileWriter *writer);
+    void run();
+    OutputFileQueue *queue() { return &m_queue; }
+  private:
+    OutputFileWriter *m_writer;
+    OutputFileQueue   m_queue;
+};
+
+/** Singleton that writes the pages produced by the output generators
+ *  to disk using a number of worker threads, so the generators do not
+ *  have to wait for the file system.
+ *
+ *  Files with the same name are always handled by the same thread,
+ *  so a file that is written more than once ends up with the contents
+ *  of the last write.
+ *
+ *  When SKIP_UNCHANGED_PAGES is enabled, the MD5 checksum of each page
+ *  is kept in a manifest, and a page is only written if its contents
+ *  differ from those of the previous run. Pages of the previous run that
+ *  are not written anymore are removed. Pages that are changed after they
+ *  have been written, i.e. the RTF output that is merged into refman.rtf
+ *  and pages with markers that are replaced by the dot graphs, are
+ *  always written, but are still removed when they are no longer written.
+ */
+class OutputFileWriter
+{
+  public:
+    static OutputFileWriter *instance();
+
+    /** Returns TRUE if files are written by the writer instead of
+     *  directly by the generators.
+     */
+    bool isActive() const { return m_workers.count()>0 || m_useSignatures; }
+
+    /** Schedules writing \a contents to file \a fileName.
+     *  The writer becomes the owner of \a contents.
+     */
+    void write(const char *fileName,QBuffer *contents);
+
+    /** Waits until all scheduled files have been written and stops
+     *  the worker threads. Updates the manifest and removes the pages that
+     *  were not written by this run. Files written after this call are 
+     *  written directly by the generators.
+     *  Returns FALSE if one of the files could not be written.
+     */
+    bool finish();
+
+  private:
+    friend class OutputWriterThread;
+    friend class OutputFileJob;
+    OutputFileWriter();
+   ~OutputFileWriter();
+    void jobDone(const char *fileName,OutputFileJob::Status status);
+    void reportFailures();
+    bool useSignatures() const { return m_useSignatures; }
+    bool isPostProcessed(const char *fileName,QBuffer *contents) const;
+    bool isUnchanged(const char *fileName,const char *sig);
+    void setSignature(const char *fileName,const char *sig);
+    void readManifest();
+    void writeManifest();
+    static OutputFileWriter *m_theInstance;
+    QList<OutputWriterThread> m_workers;
+    QMutex         m_mutex;
+    QWaitCondition m_jobDone;
+    uint           m_numPending;
+    uint           m_maxPending;
+    bool           m_ok;
+    bool           m_useSignatures;
+    QCString       m_manifestName;
+    QCString       m_rtfDir;
+    QAsciiDict<QCString> m_signatures; // checksum of the files on disk
+    QAsciiDict<void> m_written;     // files written during this run
+    QList<OutputFileError> m_failed; // files that could not be written
+};
+
+#endif
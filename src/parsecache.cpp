@@ -0,0 +1,336 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2015 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <qdir.h>
+#include <qfileinfo.h>
+#include <qstringlist.h>
+
+#include "parsecache.h"
+#include "entry.h"
+#include "section.h"
+#include "marshal.h"
+#include "filestorage.h"
+#include "filename.h"
+#include "commentscan.h"
+#include "scanner.h"
+#include "doxygen.h"
+#include "message.h"
+#include "config.h"
+#include "util.h"
+#include "version.h"
+#include "md5.h"
+
+#define PARSE_CACHE_MAGIC   0x50435332 // increase when the format changes
+#define PARSE_CACHE_SUFFIX  ".cache"
+
+//--------------------------------------------------------------------
+
+/** Returns TRUE if option \a name is relevant for the parse result. */
+static bool isParserOption(const QCString &group,const QCString &name)
+{
+  // only the options in these groups can influence the parsers
+  if (group!="Project" && group!="Build" && group!="Input" &&
+      group!="Source_Browser" && group!="Preprocessor")
+  {
+    return FALSE;
+  }
+  // options in these groups that are not used by the parsers, some of
+  // them typically change between runs.
+  static const char *ignored[] =
+  {
+    "PROJECT_NAME", "PROJECT_NUMBER", "PROJECT_BRIEF", "PROJECT_LOGO",
+    "OUTPUT_DIRECTORY", "CREATE_SUBDIRS", "LOOKUP_CACHE_SIZE",
+    "NUM_PARSE_THREADS", "NUM_OUTPUT_THREADS", "PARSE_CACHE_DIRECTORY",
+    "SKIP_UNCHANGED_PAGES",
+    "INPUT", "FILE_PATTERNS", "RECURSIVE", "EXCLUDE", "EXCLUDE_SYMLINKS",
+    0
+  };
+  const char **p = ignored;
+  while (*p)
+  {
+    if (name==*p) return FALSE;
+    p++;
+  }
+  return TRUE;
+}
+
+/** Returns a string representing everything apart from the input itself
+ *  that determines the result of the parsers.
+ */
+static QCString parserSignature()
+{
+  QCString result = "doxygen ";
+  result += versionString;
+  result += '\n';
+  QCString group;
+  QListIterator<ConfigOption> it = Config::instance()->iterator();
+  ConfigOption *option;
+  for (;(option=it.current());++it)
+  {
+    QCString value;
+    switch (option->kind())
+    {
+      case ConfigOption::O_Info:
+        group = option->name();
+        continue;
+      case ConfigOption::O_List:
+        {
+          QStrList *l = ((ConfigList*)option)->valueRef();
+          const char *s = l->first();
+          while (s)
+          {
+            value += s;
+            value += '\n';
+            s = l->next();
+          }
+        }
+        break;
+      case ConfigOption::O_Enum:
+        value = *((ConfigEnum*)option)->valueRef();
+        break;
+      case ConfigOption::O_String:
+        value = *((ConfigString*)option)->valueRef();
+        break;
+      case ConfigOption::O_Int:
+        value.setNum(*((ConfigInt*)option)->valueRef());
+        break;
+      case ConfigOption::O_Bool:
+        value = *((ConfigBool*)option)->valueRef() ? "YES" : "NO";
+        break;
+      default:
+        continue;
+    }
+    if (isParserOption(group,option->name()))
+    {
+      result += option->name()+"="+value+"\n";
+    }
+  }
+  // markdown image links depend on the images that can be found
+  QStringList images;
+  QDictIterator<FileName> fni(*Doxygen::imageNameDict);
+  for (;fni.current();++fni)
+  {
+    images.append(fni.currentKey());
+  }
+  images.sort();
+  result += images.join("\n").utf8();
+  return result;
+}
+
+static QCString md5String(const QCString &s)
+{
+  uchar md5_sig[16];
+  QCString sigStr(33);
+  MD5Buffer((const unsigned char *)s.data(),s.length(),md5_sig);
+  MD5SigToString(md5_sig,sigStr.rawData(),33);
+  return sigStr;
+}
+
+/** Returns TRUE if the tree \a e contains an entry for an anonymous scope */
+static bool hasAnonymousScope(Entry *e)
+{
+  if (e->name.find('@')!=-1) return TRUE;
+  QListIterator<Entry> eli(*e->children());
+  Entry *child;
+  for (;(child=eli.current());++eli)
+  {
+    if (hasAnonymousScope(child)) return TRUE;
+  }
+  return FALSE;
+}
+
+//--------------------------------------------------------------------
+
+ParseCache::ParseCache(const char *dirName)
+  : m_dirName(dirName), m_used(10007), m_hits(0), m_misses(0)
+{
+  QDir dir;
+  if (!dir.exists(m_dirName) && !dir.mkdir(m_dirName))
+  {
+    err("Could not create parse cache directory %s\n",m_dirName.data());
+  }
+  m_dirName = QFileInfo(m_dirName).absFilePath().utf8();
+  m_signature = md5String(parserSignature());
+}
+
+ParseCache::~ParseCache()
+{
+}
+
+bool ParseCache::isCacheable(const char *fileName)
+{
+  // the other parsers keep state between files that is not restored
+  SrcLangExt lang = getLanguageFromFileName(fileName);
+  switch (lang)
+  {
+    case SrcLangExt_IDL:
+    case SrcLangExt_Java:
+    case SrcLangExt_CSharp:
+    case SrcLangExt_D:
+    case SrcLangExt_PHP:
+    case SrcLangExt_ObjC:
+    case SrcLangExt_Cpp:
+    case SrcLangExt_JS:
+    case SrcLangExt_Markdown:
+      return TRUE;
+    default:
+      return FALSE;
+  }
+}
+
+QCString ParseCache::cacheFileName(const char *fileName) const
+{
+  return m_dirName+"/"+md5String(fileName)+PARSE_CACHE_SUFFIX;
+}
+
+Entry *ParseCache::load(const char *fileName,const char *buf,uint len)
+{
+  m_fileName = fileName;
+  m_used.insert(md5String(fileName)+PARSE_CACHE_SUFFIX,(void*)0x8);
+
+  // the key covers the signature, the file name and the parser input
+  uchar md5_sig[16];
+  struct MD5Context ctx;
+  MD5Init(&ctx);
+  MD5Update(&ctx,(const unsigned char *)m_signature.data(),m_signature.length());
+  MD5Update(&ctx,(const unsigned char *)fileName,qstrlen(fileName)+1);
+  MD5Update(&ctx,(const unsigned char *)buf,len);
+  MD5Final(md5_sig,&ctx);
+  m_key.resize(33);
+  MD5SigToString(md5_sig,m_key.rawData(),33);
+
+  // remember the state needed to check the result in store()
+  m_warnings         = warningCount();
+  m_globalDocItems   = countGlobalDocItems();
+  m_namespaceAliases = Doxygen::namespaceAliasDict.count();
+  m_sections         = Doxygen::sectionDict->count();
+  scanGetAnonCounters(m_anonCount,m_anonNSCount);
+
+  m_misses++;
+  FileStorage f(cacheFileName(fileName));
+  if (!f.open(IO_ReadOnly)) return 0;
+  if (unmarshalUInt(&f)!=PARSE_CACHE_MAGIC || unmarshalQCString(&f)!=m_key)
+  {
+    return 0;
+  }
+  bool usesAnonCounters = unmarshalBool(&f);
+  int anonCount         = unmarshalInt(&f);
+  int anonNSCount       = unmarshalInt(&f);
+  int anonCountUsed     = unmarshalInt(&f);
+  int anonNSCountUsed   = unmarshalInt(&f);
+  if (usesAnonCounters && (anonCount!=m_anonCount || anonNSCount!=m_anonNSCount))
+  {
+    // names of anonymous scopes would be different
+    return 0;
+  }
+  QList<SectionInfo> *sections = unmarshalSectionInfoList(&f);
+  if (sections)
+  {
+    QListIterator<SectionInfo> sli(*sections);
+    SectionInfo *si;
+    for (;(si=sli.current());++sli)
+    {
+      if (Doxygen::sectionDict->find(si->label))
+      {
+        // label has been used by an earlier file
+        delete sections;
+        return 0;
+      }
+    }
+  }
+  Entry *root = unmarshalEntryTree(&f);
+
+  // restore the global state
+  scanSetAnonCounters(m_anonCount+anonCountUsed,m_anonNSCount+anonNSCountUsed);
+  if (sections)
+  {
+    sections->setAutoDelete(FALSE);
+    QListIterator<SectionInfo> sli(*sections);
+    SectionInfo *si;
+    for (;(si=sli.current());++sli)
+    {
+      Doxygen::sectionDict->append(si->label,si);
+    }
+    delete sections;
+  }
+  m_misses--;
+  m_hits++;
+  return root;
+}
+
+void ParseCache::store(Entry *root)
+{
+  if (warningCount()!=m_warnings ||
+      countGlobalDocItems()!=m_globalDocItems ||
+      Doxygen::namespaceAliasDict.count()!=m_namespaceAliases)
+  {
+    // result depends on the files parsed before, or parsing needs to
+    // report warnings again on the next run.
+    return;
+  }
+  int anonCount,anonNSCount;
+  scanGetAnonCounters(anonCount,anonNSCount);
+  bool usesAnonCounters = anonCount!=m_anonCount || hasAnonymousScope(root);
+
+  QList<SectionInfo> sections;
+  int i;
+  for (i=m_sections;i<Doxygen::sectionDict->count();i++)
+  {
+    sections.append(Doxygen::sectionDict->at(i));
+  }
+
+  // write to a temporary file first, so an interrupted run does not
+  // leave a truncated result behind
+  QCString fileName = cacheFileName(m_fileName);
+  QCString tmpName  = fileName+".tmp";
+  {
+    FileStorage f(tmpName);
+    if (!f.open(IO_WriteOnly))
+    {
+      err("Could not open file %s for writing\n",tmpName.data());
+      return;
+    }
+    marshalUInt(&f,PARSE_CACHE_MAGIC);
+    marshalQCString(&f,m_key);
+    marshalBool(&f,usesAnonCounters);
+    marshalInt(&f,m_anonCount);
+    marshalInt(&f,m_anonNSCount);
+    marshalInt(&f,anonCount-m_anonCount);
+    marshalInt(&f,anonNSCount-m_anonNSCount);
+    marshalSectionInfoList(&f,&sections);
+    marshalEntryTree(&f,root);
+    f.close();
+  }
+  QDir dir;
+  dir.remove(fileName);
+  if (!dir.rename(tmpName,fileName))
+  {
+    err("Could not rename file %s to %s\n",tmpName.data(),fileName.data());
+  }
+}
+
+void ParseCache::removeUnused()
+{
+  QDir dir(m_dirName);
+  QStringList files = dir.entryList(QCString("*")+PARSE_CACHE_SUFFIX,QDir::Files);
+  QStringList::Iterator it;
+  for (it=files.begin();it!=files.end();++it)
+  {
+    if (m_used.find((*it).utf8())==0)
+    {
+      dir.remove(*it);
+    }
+  }
+}
@@ -0,0 +1,83 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2015 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef PARSECACHE_H
+#define PARSECACHE_H
+
+#include <qcstring.h>
+#include <qdict.h>
+
+class Entry;
+
+/** Persistent cache for the Entry trees produced by the language parsers.
+ *
+ *  The result of parsing a file is stored in a directory, keyed by the MD5
+ *  checksum of the text passed to the parser (i.e. the contents of the file
+ *  after preprocessing, so including the effect of the files it includes),
+ *  the name of the file, and the configuration options that affect parsing.
+ *  A next run reads the Entry tree back instead of parsing the file again.
+ *
+ *  Since some parsers share state between files, only results that do not
+ *  depend on the files parsed before are stored. The counters used to name
+ *  anonymous scopes and the section labels found in the file are stored
+ *  with the result and restored when it is used.
+ */
+class ParseCache
+{
+  public:
+    ParseCache(const char *dirName);
+   ~ParseCache();
+
+    /** Returns TRUE if the result of parsing \a fileName may be cached. */
+    static bool isCacheable(const char *fileName);
+
+    /** Returns the parse result stored for file \a fileName, where \a buf
+     *  of \a len bytes is the input for the parser, or 0 if the file needs
+     *  to be parsed. In the latter case the result of parsing should be
+     *  passed to store(). The caller becomes the owner of the returned tree.
+     */
+    Entry *load(const char *fileName,const char *buf,uint len);
+
+    /** Stores the tree \a root that resulted from parsing the file that
+     *  was passed to the last call to load().
+     */
+    void store(Entry *root);
+
+    /** Removes the results for files that were not parsed during this run. */
+    void removeUnused();
+
+    int hits() const   { return m_hits; }
+    int misses() const { return m_misses; }
+
+  private:
+    QCString cacheFileName(const char *fileName) const;
+    QCString    m_dirName;
+    QCString    m_signature;
+    QDict<void> m_used;
+    int         m_hits;
+    int         m_misses;
+
+    // state at the start of parsing the current file
+    QCString    m_fileName;
+    QCString    m_key;
+    int         m_warnings;
+    int         m_globalDocItems;
+    uint        m_namespaceAliases;
+    int         m_sections;
+    int         m_anonCount;
+    int         m_anonNSCount;
+};
+
+#endif
@@ -20,16 +20,24 @@
 
 #include "parserintf.h"
 
+struct ScannerContext;
+
 /** \brief C-like language parser using state-based lexical scanning.
  *
  *  This is the language parser for doxygen. It is somewhat fuzzy and
  *  supports C++ and various languages that are closely related to C++, 
  *  such as C, C#, Objective-C, Java, PHP, and IDL.
+ *
+ *  The scanner keeps part of the state of a parse in a context owned by
+ *  the scanner object and the rest in global variables. It also updates
+ *  doxygen's global dictionaries, so parseInput() may only be called from
+ *  the main thread.
  */
 class CLanguageScanner : public ParserInterface
 {
   public:
-    virtual ~CLanguageScanner() {}
+    CLanguageScanner();
+    virtual ~CLanguageScanner();
     void startTranslationUnit(const char *fileName);
     void finishTranslationUnit();
     void parseInput(const char *fileName,
@@ -55,8 +63,18 @@ class CLanguageScanner : public ParserInterface
                   );
     void resetCodeParserState();
     void parsePrototype(const char *text);
+  private:
+    ScannerContext *m_context;
 };
 
 void scanFreeScanner();
 
+/** Gets the counters used to name anonymous scopes. These are shared 
+ *  by all files parsed with the C-like scanner.
+ */
+void scanGetAnonCounters(int &anonCount,int &anonNSCount);
+
+/** Sets the counters used to name anonymous scopes. */
+void scanSetAnonCounters(int anonCount,int anonNSCount);
+
 #endif
@@ -0,0 +1,97 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2015 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include "stringpool.h"
+
+// strings of up to SHORT_STR_MAX_LEN characters are stored inside the
+// QCString itself and cannot be shared, so there is no need to keep them
+// in the pool. SHORT_STR_MAX_LEN is only usable inside QCString, so the
+// limit is derived from the same layout as QCString::LongStringRep.
+struct LongStringRepLayout { uchar isShort; void *d; };
+#define MIN_POOLED_LENGTH ((uint)sizeof(LongStringRepLayout)-2) // SHORT_STR_MAX_LEN+1
+
+StringPool::Slot *StringPool::m_slots = 0;
+uint              StringPool::m_size  = 0;
+uint              StringPool::m_count = 0;
+
+uint StringPool::lookup(const char *s,uint hash)
+{
+  uint mask=m_size-1;
+  uint i=hash&mask;
+  // the table is never full, so this ends at an empty slot
+  while (!m_slots[i].str.isEmpty())
+  {
+    if (m_slots[i].hash==hash && qstrcmp(m_slots[i].str.data(),s)==0)
+    {
+      break;
+    }
+    i=(i+1)&mask;
+  }
+  return i;
+}
+
+void StringPool::resize(uint size)
+{
+  Slot *oldSlots = m_slots;
+  uint  oldSize  = m_size;
+  m_slots = new Slot[size];
+  m_size  = size;
+  uint i;
+  for (i=0;i<oldSize;i++)
+  {
+    Slot &s = oldSlots[i];
+    if (!s.str.isEmpty())
+    {
+      Slot &ns = m_slots[lookup(s.str,s.hash)];
+      ns.hash = s.hash;
+      ns.str  = s.str;
+    }
+  }
+  delete[] oldSlots;
+}
+
+QCString StringPool::intern(const QCString &s)
+{
+  if (s.length()<MIN_POOLED_LENGTH) return s;
+  if (m_slots==0) resize(65536);
+
+  // FNV-1a
+  uint hash=2166136261u;
+  const uchar *p=(const uchar *)s.data();
+  while (*p)
+  {
+    hash^=*p++;
+    hash*=16777619u;
+  }
+
+  Slot *slot = &m_slots[lookup(s,hash)];
+  if (slot->str.isEmpty()) // new string
+  {
+    if ((m_count+1)*2>m_size) // keep the load factor below 1/2
+    {
+      resize(m_size*2);
+      slot = &m_slots[lookup(s,hash)];
+    }
+    slot->hash = hash;
+    slot->str  = s.copy(); // the pool owns its own buffer
+    m_count++;
+  }
+  return slot->str;
+}
+
+uint StringPool::count()
+{
+  return m_count;
+}
@@ -0,0 +1,55 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2015 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <qcstring.h>
+
+/** Pool of strings that are stored by many objects, such as file names
+ *  and qualified names.
+ *
+ *  intern() returns a copy of the string kept in the pool, so all objects
+ *  that store the same string share a single buffer, since QCString shares
+ *  the data of long strings between copies. Short strings are stored inside
+ *  QCString itself, so interning them has no effect.
+ *
+ *  The pool is not thread safe, so it should only be used from the thread
+ *  that builds the definitions.
+ */
+class StringPool
+{
+  public:
+    /** Returns the copy of string \a s kept in the pool. */
+    static QCString intern(const QCString &s);
+
+    /** Returns the number of strings in the pool. */
+    static uint count();
+
+  private:
+    struct Slot
+    {
+      Slot() : hash(0) {}
+      uint     hash;
+      QCString str;
+    };
+    static uint lookup(const char *s,uint hash);
+    static void resize(uint size);
+    static Slot *m_slots;
+    static uint  m_size;
+    static uint  m_count;
+};
+
+#endif
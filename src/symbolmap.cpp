@@ -0,0 +1,159 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2015 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <stdlib.h>
+
+#include "symbolmap.h"
+
+//--------------------------------------------------------------------
+
+SymbolList::SymbolList() : m_items(0), m_count(0), m_size(0)
+{
+}
+
+SymbolList::~SymbolList()
+{
+  free(m_items);
+}
+
+void SymbolList::append(Definition *d)
+{
+  if (m_count==m_size)
+  {
+    m_size = m_size==0 ? 2 : m_size*2;
+    m_items = (Definition **)realloc(m_items,m_size*sizeof(Definition*));
+  }
+  m_items[m_count++]=d;
+}
+
+bool SymbolList::remove(Definition *d)
+{
+  uint i;
+  for (i=0;i<m_count;i++)
+  {
+    if (m_items[i]==d)
+    {
+      // keep the order of the remaining definitions
+      m_count--;
+      for (;i<m_count;i++) m_items[i]=m_items[i+1];
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+//--------------------------------------------------------------------
+
+SymbolMap::SymbolMap(uint size) : m_size(16), m_count(0)
+{
+  while (m_size<size) m_size*=2;
+  m_slots = new Slot[m_size];
+}
+
+SymbolMap::~SymbolMap()
+{
+  uint i;
+  for (i=0;i<m_size;i++)
+  {
+    delete m_slots[i].list;
+  }
+  delete[] m_slots;
+}
+
+uint SymbolMap::hashName(const char *name)
+{
+  // FNV-1a
+  uint h=2166136261u;
+  const uchar *p=(const uchar *)name;
+  while (*p)
+  {
+    h^=*p++;
+    h*=16777619u;
+  }
+  return h;
+}
+
+uint SymbolMap::lookup(const char *name,uint hash) const
+{
+  uint mask=m_size-1;
+  uint i=hash&mask;
+  // the table is never full, so this ends at an empty slot
+  while (m_slots[i].list)
+  {
+    if (m_slots[i].hash==hash && qstrcmp(m_slots[i].name.data(),name)==0)
+    {
+      break;
+    }
+    i=(i+1)&mask;
+  }
+  return i;
+}
+
+void SymbolMap::resize(uint size)
+{
+  Slot *oldSlots = m_slots;
+  uint  oldSize  = m_size;
+  m_slots = new Slot[size];
+  m_size  = size;
+  uint i;
+  for (i=0;i<oldSize;i++)
+  {
+    Slot &s = oldSlots[i];
+    if (s.list)
+    {
+      Slot &ns = m_slots[lookup(s.name,s.hash)];
+      ns.hash = s.hash;
+      ns.name = s.name;
+      ns.list = s.list;
+    }
+  }
+  delete[] oldSlots;
+}
+
+QCString SymbolMap::add(const char *name,Definition *d)
+{
+  uint hash=hashName(name);
+  Slot *s = &m_slots[lookup(name,hash)];
+  if (s->list==0) // new name
+  {
+    if ((m_count+1)*2>m_size) // keep the load factor below 1/2
+    {
+      resize(m_size*2);
+      s = &m_slots[lookup(name,hash)];
+    }
+    s->hash = hash;
+    s->name = name;
+    s->list = new SymbolList;
+    m_count++;
+  }
+  s->list->append(d);
+  return s->name;
+}
+
+void SymbolMap::remove(const char *name,Definition *d)
+{
+  Slot &s = m_slots[lookup(name,hashName(name))];
+  if (s.list)
+  {
+    s.list->remove(d);
+  }
+}
+
+const SymbolList *SymbolMap::find(const char *name) const
+{
+  if (name==0) return 0;
+  const Slot &s = m_slots[lookup(name,hashName(name))];
+  return s.list && s.list->count()>0 ? s.list : 0;
+}
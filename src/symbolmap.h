@@ -0,0 +1,116 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2015 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef SYMBOLMAP_H
+#define SYMBOLMAP_H
+
+#include <qcstring.h>
+
+class Definition;
+
+/** The definitions that share the same symbol name. */
+class SymbolList
+{
+  public:
+    /** Returns the number of definitions in the list. */
+    uint count() const { return m_count; }
+
+    /** Returns the definition at index \a i. */
+    Definition *at(uint i) const { return m_items[i]; }
+
+  private:
+    friend class SymbolMap;
+    SymbolList();
+   ~SymbolList();
+    void append(Definition *d);
+    bool remove(Definition *d);
+    Definition **m_items;
+    uint         m_count;
+    uint         m_size;
+};
+
+/** Table mapping the (unqualified) name of a symbol to the definitions
+ *  with that name.
+ *
+ *  The table uses open addressing with linear probing. Each name is
+ *  stored once together with its hash value, and the definitions for a name
+ *  are kept in an array. Names are never removed from the table, a name
+ *  without definitions is simply not found anymore. This means the list
+ *  returned by find() stays valid while symbols are added or removed.
+ *
+ *  The const methods do not modify the table, so they can be called from
+ *  multiple threads at the same time, as long as no symbols are added or
+ *  removed.
+ */
+class SymbolMap
+{
+  public:
+    SymbolMap(uint size=65536);
+   ~SymbolMap();
+
+    /** Adds definition \a d for symbol \a name. Returns the name as
+     *  stored in the table.
+     */
+    QCString add(const char *name,Definition *d);
+
+    /** Removes definition \a d for symbol \a name. */
+    void remove(const char *name,Definition *d);
+
+    /** Returns the definitions for symbol \a name or 0 if there are none. */
+    const SymbolList *find(const char *name) const;
+
+    /** Returns the number of names in the table. */
+    uint count() const { return m_count; }
+
+    /** Iterator over the names in the table that have definitions. */
+    class Iterator
+    {
+      public:
+        Iterator(const SymbolMap &map) : m_map(map), m_index(0) { skip(); }
+        const SymbolList *current() const
+        { return m_index<m_map.m_size ? m_map.m_slots[m_index].list : 0; }
+        const QCString &currentKey() const
+        { return m_map.m_slots[m_index].name; }
+        void operator++() { m_index++; skip(); }
+      private:
+        void skip()
+        {
+          while (m_index<m_map.m_size &&
+                 (m_map.m_slots[m_index].list==0 ||
+                  m_map.m_slots[m_index].list->count()==0)) m_index++;
+        }
+        const SymbolMap &m_map;
+        uint m_index;
+    };
+
+  private:
+    friend class Iterator;
+    struct Slot
+    {
+      Slot() : hash(0), list(0) {}
+      uint        hash;
+      QCString    name;
+      SymbolList *list;
+    };
+    static uint hashName(const char *name);
+    uint lookup(const char *name,uint hash) const;
+    void resize(uint size);
+
+    Slot *m_slots;
+    uint  m_size;   // always a power of two
+    uint  m_count;
+};
+
+#endif
@@ -61,6 +61,8 @@
 #include "membergroup.h"
 #include "dirdef.h"
 #include "htmlentity.h"
+#include "symbolmap.h"
+#include "lookupcache.h"
 
 #define ENABLE_TRACINGSUPPORT 0
 
@@ -669,52 +671,34 @@ static QCString substTypedef(Definition *scope,FileDef *fileScope,const QCString
   if (name.isEmpty()) return result;
 
   // lookup scope fragment in the symbol map
-  DefinitionIntf *di = Doxygen::symbolMap->find(name);
-  if (di==0) return result; // no matches
+  const SymbolList *sl = Doxygen::symbolMap->find(name);
+  if (sl==0) return result; // no matches
 
+  // search for the best match
   MemberDef *bestMatch=0;
-  if (di->definitionType()==DefinitionIntf::TypeSymbolList) // multi symbols
+  int minDistance=10000; // init at "infinite"
+  uint i;
+  for (i=0;i<sl->count();i++) // foreach definition
   {
-    // search for the best match
-    DefinitionListIterator dli(*(DefinitionList*)di);
-    Definition *d;
-    int minDistance=10000; // init at "infinite"
-    for (dli.toFirst();(d=dli.current());++dli) // foreach definition
+    Definition *d = sl->at(i);
+    // only look at members
+    if (d->definitionType()==Definition::TypeMember)
     {
-      // only look at members
-      if (d->definitionType()==Definition::TypeMember)
+      // that are also typedefs
+      MemberDef *md = (MemberDef *)d;
+      if (md->isTypedef()) // d is a typedef
       {
-        // that are also typedefs
-        MemberDef *md = (MemberDef *)d;
-        if (md->isTypedef()) // d is a typedef
+        // test accessibility of typedef within scope.
+        int distance = isAccessibleFromWithExpScope(scope,fileScope,d,"");
+        if (distance!=-1 && distance<minDistance) 
+          // definition is accessible and a better match
         {
-          // test accessibility of typedef within scope.
-          int distance = isAccessibleFromWithExpScope(scope,fileScope,d,"");
-          if (distance!=-1 && distance<minDistance) 
-            // definition is accessible and a better match
-          {
-            minDistance=distance;
-            bestMatch = md; 
-          }
+          minDistance=distance;
+          bestMatch = md; 
         }
       }
     }
   }
-  else if (di->definitionType()==DefinitionIntf::TypeMember) // single symbol
-  {
-    Definition *d = (Definition*)di;
-    // that are also typedefs
-    MemberDef *md = (MemberDef *)di;
-    if (md->isTypedef()) // d is a typedef
-    {
-      // test accessibility of typedef within scope.
-      int distance = isAccessibleFromWithExpScope(scope,fileScope,d,"");
-      if (distance!=-1) // definition is accessible 
-      {
-        bestMatch = md; 
-      }
-    }
-  }
   if (bestMatch) 
   {
     result = bestMatch->typeString();
@@ -901,6 +885,10 @@ class AccessStack
     {
       if (m_index>0) m_index--;
     }
+    bool isEmpty() const
+    {
+      return m_index==0;
+    }
     bool find(Definition *scope,FileDef *fileScope, Definition *item)
     {
       int i=0;
@@ -941,6 +929,168 @@ class AccessStack
     AccessElem m_elements[MAX_STACK_SIZE];
 };
 
+/** Cache of the results of isAccessibleFrom() and 
+ *  isAccessibleFromWithExpScope().
+ *
+ *  The result of a call depends on the calls that are in progress, since
+ *  a call that is already on the AccessStack fails. Therefore only
+ *  the results of calls that are not nested in another call are stored.
+ *  The results also depend on the relations between the symbols, which
+ *  change while the input is processed, so the cache is only used once
+ *  it has been enabled with setAccessCacheEnabled().
+ */
+class AccessCache
+{
+  public:
+    AccessCache() : m_buckets(0), m_numBuckets(0), m_count(0),
+                    m_enabled(FALSE), m_hits(0), m_misses(0) {}
+   ~AccessCache()
+    {
+      clear();
+      delete[] m_buckets;
+    }
+    bool isEnabled() const { return m_enabled; }
+    void setEnabled(bool enable)
+    {
+      m_enabled=enable;
+      if (!enable) clear();
+    }
+    bool find(Definition *scope,FileDef *fileScope,Definition *item,
+              const QCString &expScope,int &result)
+    {
+      if (m_count==0) { m_misses++; return FALSE; }
+      uint h = hash(scope,fileScope,item,expScope);
+      Elem *e = m_buckets[h&(m_numBuckets-1)];
+      while (e)
+      {
+        if (e->hash==h && e->scope==scope && e->fileScope==fileScope &&
+            e->item==item && e->expScope==expScope)
+        {
+          m_hits++;
+          result=e->result;
+          return TRUE;
+        }
+        e=e->next;
+      }
+      m_misses++;
+      return FALSE;
+    }
+    void insert(Definition *scope,FileDef *fileScope,Definition *item,
+                const QCString &expScope,int result)
+    {
+      if (m_count>=MaxCount) // start over rather than grow without bounds
+      {
+        clear();
+      }
+      if (m_count>=m_numBuckets)
+      {
+        resize(m_numBuckets==0 ? 1024 : m_numBuckets*2);
+      }
+      Elem *e = new Elem;
+      e->scope     = scope;
+      e->fileScope = fileScope;
+      e->item      = item;
+      e->expScope  = expScope;
+      e->result    = result;
+      e->hash      = hash(scope,fileScope,item,expScope);
+      Elem **pe = &m_buckets[e->hash&(m_numBuckets-1)];
+      e->next = *pe;
+      *pe = e;
+      m_count++;
+    }
+    void clear()
+    {
+      uint i;
+      for (i=0;i<m_numBuckets;i++)
+      {
+        Elem *e = m_buckets[i];
+        while (e)
+        {
+          Elem *next = e->next;
+          delete e;
+          e = next;
+        }
+        m_buckets[i]=0;
+      }
+      m_count=0;
+    }
+    uint count() const  { return m_count;  }
+    uint hits() const   { return m_hits;   }
+    uint misses() const { return m_misses; }
+
+  private:
+    enum { MaxCount = 1<<20 };
+    /** Element in a hash chain */
+    struct Elem
+    {
+      Definition *scope;
+      FileDef    *fileScope;
+      Definition *item;
+      QCString    expScope;
+      int         result;
+      uint        hash;
+      Elem       *next;
+    };
+    static uint hash(Definition *scope,FileDef *fileScope,Definition *item,
+                     const QCString &expScope)
+    {
+      // FNV-1a over the pointers and the explicit scope
+      uint h=2166136261u;
+      h=(h^(uint)(((size_t)scope)>>3))*16777619u;
+      h=(h^(uint)(((size_t)fileScope)>>3))*16777619u;
+      h=(h^(uint)(((size_t)item)>>3))*16777619u;
+      const uchar *p=(const uchar *)expScope.data();
+      if (p)
+      {
+        while (*p) { h^=*p++; h*=16777619u; }
+      }
+      return h;
+    }
+    void resize(uint numBuckets)
+    {
+      Elem **oldBuckets = m_buckets;
+      uint oldNumBuckets = m_numBuckets;
+      m_buckets = new Elem*[numBuckets];
+      memset(m_buckets,0,numBuckets*sizeof(Elem*));
+      m_numBuckets = numBuckets;
+      uint i;
+      for (i=0;i<oldNumBuckets;i++)
+      {
+        Elem *e = oldBuckets[i];
+        while (e)
+        {
+          Elem *next = e->next;
+          Elem **pe = &m_buckets[e->hash&(m_numBuckets-1)];
+          e->next = *pe;
+          *pe = e;
+          e = next;
+        }
+      }
+      delete[] oldBuckets;
+    }
+
+    Elem **m_buckets;
+    uint   m_numBuckets; // always a power of two
+    uint   m_count;
+    bool   m_enabled;
+    uint   m_hits;
+    uint   m_misses;
+};
+
+static AccessCache g_accessCache;
+
+void setAccessCacheEnabled(bool enable)
+{
+  g_accessCache.setEnabled(enable);
+}
+
+void accessCacheStats(uint &count,uint &hits,uint &misses)
+{
+  count  = g_accessCache.count();
+  hits   = g_accessCache.hits();
+  misses = g_accessCache.misses();
+}
+
 /* Returns the "distance" (=number of levels up) from item to scope, or -1
  * if item in not inside scope. 
  */
@@ -950,15 +1100,19 @@ int isAccessibleFrom(Definition *scope,FileDef *fileScope,Definition *item)
   //    scope->name().data(),item->name().data(),item->getOuterScope()->name().data());
 
   static AccessStack accessStack;
+  int result=0; // assume we found it
+  int i;
+  bool useCache = g_accessCache.isEnabled() && accessStack.isEmpty();
+  if (useCache && g_accessCache.find(scope,fileScope,item,QCString(),result))
+  {
+    return result;
+  }
   if (accessStack.find(scope,fileScope,item))
   {
     return -1;
   }
   accessStack.push(scope,fileScope,item);
 
-  int result=0; // assume we found it
-  int i;
-
   Definition *itemScope=item->getOuterScope();
   bool memberAccessibleFromScope = 
       (item->definitionType()==Definition::TypeMember &&                   // a member
@@ -1027,7 +1181,7 @@ int isAccessibleFrom(Definition *scope,FileDef *fileScope,Definition *item)
   }
 done:
   accessStack.pop();
-  //Doxygen::lookupCache.insert(key,new int(result));
+  if (useCache) g_accessCache.insert(scope,fileScope,item,QCString(),result);
   return result;
 }
 
@@ -1057,6 +1211,12 @@ int isAccessibleFromWithExpScope(Definition *scope,FileDef *fileScope,
   }
 
   static AccessStack accessStack;
+  bool useCache = g_accessCache.isEnabled() && accessStack.isEmpty();
+  int cachedResult;
+  if (useCache && g_accessCache.find(scope,fileScope,item,explicitScopePart,cachedResult))
+  {
+    return cachedResult;
+  }
   if (accessStack.find(scope,fileScope,item,explicitScopePart))
   {
     return -1;
@@ -1195,7 +1355,7 @@ int isAccessibleFromWithExpScope(Definition *scope,FileDef *fileScope,
 done:
   //printf("  > result=%d\n",result);
   accessStack.pop();
-  //Doxygen::lookupCache.insert(key,new int(result));
+  if (useCache) g_accessCache.insert(scope,fileScope,item,explicitScopePart,result);
   return result;
 }
 
@@ -1409,16 +1569,16 @@ static ClassDef *getResolvedClassRec(Definition *scope,
   }
 
   //printf("Looking for symbol %s\n",name.data());
-  DefinitionIntf *di = Doxygen::symbolMap->find(name);
+  const SymbolList *sl = Doxygen::symbolMap->find(name);
   // the -g (for C# generics) and -p (for ObjC protocols) are now already 
   // stripped from the key used in the symbolMap, so that is not needed here.
-  if (di==0) 
+  if (sl==0) 
   {
-    //di = Doxygen::symbolMap->find(name+"-g");
-    //if (di==0)
+    //sl = Doxygen::symbolMap->find(name+"-g");
+    //if (sl==0)
     //{
-      di = Doxygen::symbolMap->find(name+"-p");
-      if (di==0)
+      sl = Doxygen::symbolMap->find(name+"-p");
+      if (sl==0)
       {
         //printf("no such symbol!\n");
         return 0;
@@ -1437,59 +1597,35 @@ static ClassDef *getResolvedClassRec(Definition *scope,
   // Since it is often the case that the same name is searched in the same
   // scope over an over again (especially for the linked source code generation)
   // we use a cache to collect previous results. This is possible since the
-  // result of a lookup is deterministic. As the key we use the concatenated
-  // scope, the name to search for and the explicit scope prefix. The speedup
+  // result of a lookup is deterministic. As the key we use the scope, 
+  // the name to search for and the explicit scope prefix. The speedup
   // achieved by this simple cache can be enormous.
-  int scopeNameLen = scope->name().length()+1;
-  int nameLen = name.length()+1;
-  int explicitPartLen = explicitScopePart.length();
-  int fileScopeLen = hasUsingStatements ? 1+fileScope->absFilePath().length() : 0;
-
-  // below is a more efficient coding of
-  // QCString key=scope->name()+"+"+name+"+"+explicitScopePart;
-  QCString key(scopeNameLen+nameLen+explicitPartLen+fileScopeLen+1);
-  char *p=key.rawData();
-  qstrcpy(p,scope->name()); *(p+scopeNameLen-1)='+';
-  p+=scopeNameLen;
-  qstrcpy(p,name); *(p+nameLen-1)='+';
-  p+=nameLen;
-  qstrcpy(p,explicitScopePart);
-  p+=explicitPartLen;
-
-  // if a file scope is given and it contains using statements we should
-  // also use the file part in the key (as a class name can be in
+  // If a file scope is given and it contains using statements we should
+  // also use the file in the key (as a class name can be in
   // two different namespaces and a using statement in a file can select 
   // one of them).
-  if (hasUsingStatements)
-  {
-    // below is a more efficient coding of
-    // key+="+"+fileScope->name();
-    *p++='+';
-    qstrcpy(p,fileScope->absFilePath());
-    p+=fileScopeLen-1;
-  }
-  *p='\0';
+  LookupKey key(scope->name(),name,explicitScopePart,
+                hasUsingStatements ? fileScope->absFilePath() : QCString());
 
-  LookupInfo *pval=Doxygen::lookupCache->find(key);
-  //printf("Searching for %s result=%p\n",key.data(),pval);
-  if (pval)
+  LookupInfo cached;
+  if (Doxygen::lookupCache->find(key,cached))
   {
     //printf("LookupInfo %p %p '%s' %p\n", 
-    //    pval->classDef, pval->typeDef, pval->templSpec.data(), 
-    //    pval->resolvedType.data()); 
-    if (pTemplSpec)    *pTemplSpec=pval->templSpec;
-    if (pTypeDef)      *pTypeDef=pval->typeDef;
-    if (pResolvedType) *pResolvedType=pval->resolvedType;
+    //    cached.classDef, cached.typeDef, cached.templSpec.data(), 
+    //    cached.resolvedType.data()); 
+    if (pTemplSpec)    *pTemplSpec=cached.templSpec;
+    if (pTypeDef)      *pTypeDef=cached.typeDef;
+    if (pResolvedType) *pResolvedType=cached.resolvedType;
     //printf("] cachedMatch=%s\n",
-    //    pval->classDef?pval->classDef->name().data():"<none>");
+    //    cached.classDef?cached.classDef->name().data():"<none>");
     //if (pTemplSpec) 
     //  printf("templSpec=%s\n",pTemplSpec->data());
-    return pval->classDef; 
+    return cached.classDef; 
   }
   else // not found yet; we already add a 0 to avoid the possibility of 
     // endless recursion.
   {
-    Doxygen::lookupCache->insert(key,new LookupInfo);
+    Doxygen::lookupCache->insert(key,LookupInfo());
   }
 
   ClassDef *bestMatch=0;
@@ -1498,24 +1634,12 @@ static ClassDef *getResolvedClassRec(Definition *scope,
   QCString bestResolvedType;
   int minDistance=10000; // init at "infinite"
 
-  if (di->definitionType()==DefinitionIntf::TypeSymbolList) // not a unique name
-  {
-    //printf("  name is not unique\n");
-    DefinitionListIterator dli(*(DefinitionList*)di);
-    Definition *d;
-    int count=0;
-    for (dli.toFirst();(d=dli.current());++dli,++count) // foreach definition
-    {
-      getResolvedSymbol(scope,fileScope,d,explicitScopePart,&actTemplParams,
-                        minDistance,bestMatch,bestTypedef,bestTemplSpec,
-                        bestResolvedType);
-    }
-  }
-  else // unique name
+  // note that sl->count() may grow while resolving, since new 
+  // definitions can be added to the symbol map.
+  uint i;
+  for (i=0;i<sl->count();i++) // foreach definition
   {
-    //printf("  name is unique\n");
-    Definition *d = (Definition *)di;
-    getResolvedSymbol(scope,fileScope,d,explicitScopePart,&actTemplParams,
+    getResolvedSymbol(scope,fileScope,sl->at(i),explicitScopePart,&actTemplParams,
                       minDistance,bestMatch,bestTypedef,bestTemplSpec,
                       bestResolvedType);
   }
@@ -1535,18 +1659,7 @@ static ClassDef *getResolvedClassRec(Definition *scope,
   //printf("getResolvedClassRec: bestMatch=%p pval->resolvedType=%s\n",
   //    bestMatch,bestResolvedType.data());
 
-  pval=Doxygen::lookupCache->find(key);
-  if (pval)
-  {
-    pval->classDef     = bestMatch;
-    pval->typeDef      = bestTypedef;
-    pval->templSpec    = bestTemplSpec;
-    pval->resolvedType = bestResolvedType;
-  }
-  else
-  {
-    Doxygen::lookupCache->insert(key,new LookupInfo(bestMatch,bestTypedef,bestTemplSpec,bestResolvedType));
-  }
+  Doxygen::lookupCache->insert(key,LookupInfo(bestMatch,bestTypedef,bestTemplSpec,bestResolvedType));
   //printf("] bestMatch=%s distance=%d\n",
   //    bestMatch?bestMatch->name().data():"<none>",minDistance);
   //if (pTemplSpec) 
@@ -1912,7 +2025,158 @@ bool leftScopeMatch(const QCString &scope, const QCString &name)
 }
 
 
-void linkifyText(const TextGeneratorIntf &out,Definition *scope,
+//----------------------------------------------------------------------
+
+/** Result of getDefs() or resolveRef() as kept in the cache. */
+struct ResolveCacheElem
+{
+  ResolveCacheElem() : found(FALSE), md(0), cd(0), fd(0), nd(0), gd(0), context(0) {}
+  bool          found;
+  MemberDef    *md;
+  ClassDef     *cd;
+  FileDef      *fd;
+  NamespaceDef *nd;
+  GroupDef     *gd;
+  Definition   *context;
+};
+
+// Documentation refers to the same symbols from the same scopes over and
+// over again, so the results of resolving references are cached once the
+// symbols and their relations are known (see setResolveCacheEnabled()).
+static QCache<ResolveCacheElem> g_resolveCache(100000,10007);
+static bool g_resolveCacheEnabled = FALSE;
+static uint g_resolveCacheHits;
+static uint g_resolveCacheMisses;
+
+/** The output of linkifyText() for a text, recorded as the calls it makes
+ *  to a TextGeneratorIntf, so it can be replayed for another output format
+ *  or another listing of the same declaration.
+ */
+class LinkifiedText : public TextGeneratorIntf
+{
+  public:
+    LinkifiedText() : m_size(0) { m_items.setAutoDelete(TRUE); }
+    void writeString(const char *s,bool keepSpaces) const
+    {
+      Item *item = new Item(Item::String);
+      item->text       = s;
+      item->keepSpaces = keepSpaces;
+      m_items.append(item);
+      m_size+=item->text.length();
+    }
+    void writeBreak(int indent) const
+    {
+      Item *item = new Item(Item::Break);
+      item->indent = indent;
+      m_items.append(item);
+    }
+    void writeLink(const char *extRef,const char *file,
+                   const char *anchor,const char *text
+                  ) const
+    {
+      Item *item = new Item(Item::Link);
+      item->extRef = extRef;
+      item->file   = file;
+      item->anchor = anchor;
+      item->text   = text;
+      m_items.append(item);
+      m_size+=item->extRef.length()+item->file.length()+
+              item->anchor.length()+item->text.length();
+    }
+    void replay(const TextGeneratorIntf &out) const
+    {
+      QListIterator<Item> li(m_items);
+      Item *item;
+      for (;(item=li.current());++li)
+      {
+        switch (item->kind)
+        {
+          case Item::String:
+            out.writeString(item->text,item->keepSpaces);
+            break;
+          case Item::Break:
+            out.writeBreak(item->indent);
+            break;
+          case Item::Link:
+            out.writeLink(item->extRef,item->file,item->anchor,item->text);
+            break;
+        }
+      }
+    }
+    /** Returns the approximate number of bytes used by the text. */
+    uint size() const { return m_size+m_items.count()*sizeof(Item); }
+
+  private:
+    /** A call to one of the methods of TextGeneratorIntf */
+    struct Item
+    {
+      enum Kind { String, Break, Link };
+      Item(Kind k) : kind(k), keepSpaces(FALSE), indent(0) {}
+      Kind     kind;
+      bool     keepSpaces;
+      int      indent;
+      QCString extRef;
+      QCString file;
+      QCString anchor;
+      QCString text;
+    };
+    mutable QList<Item> m_items;
+    mutable uint m_size;
+};
+
+// The same declarations are linkified for every output format and for
+// every listing they appear in, so the results are cached together with the
+// resolved references (see setResolveCacheEnabled()).
+static QCache<LinkifiedText> g_linkifyCache(8*1024*1024,10007);
+
+void initResolveCache()
+{
+  g_resolveCache.setAutoDelete(TRUE);
+  g_linkifyCache.setAutoDelete(TRUE);
+}
+
+void setResolveCacheEnabled(bool enable)
+{
+  g_resolveCacheEnabled = enable;
+  if (!enable)
+  {
+    g_resolveCache.clear();
+    g_linkifyCache.clear();
+  }
+}
+
+void resolveCacheStats(uint &count,uint &size,uint &hits,uint &misses)
+{
+  count  = g_resolveCache.count();
+  size   = g_resolveCache.maxCost();
+  hits   = g_resolveCacheHits;
+  misses = g_resolveCacheMisses;
+}
+
+/*! Returns the cached result for \a key or 0 if there is none. */
+static ResolveCacheElem *findResolveCache(const QCString &key)
+{
+  ResolveCacheElem *elem = g_resolveCache.find(key);
+  if (elem) g_resolveCacheHits++; else g_resolveCacheMisses++;
+  return elem;
+}
+
+static void insertResolveCache(const QCString &key,ResolveCacheElem *elem)
+{
+  if (!g_resolveCache.insert(key,elem))
+  {
+    delete elem;
+  }
+}
+
+/*! Appends \a s to \a key such that a null string differs from an empty one. */
+static void addKeyPart(QCString &key,const char *s)
+{
+  if (s) { key+='+'; key+=s; } else key+='-';
+  key+='\n';
+}
+
+static void linkifyTextUncached(const TextGeneratorIntf &out,Definition *scope,
     FileDef *fileScope,Definition *self,
     const char *text, bool autoBreak,bool external,
     bool keepSpaces,int indentLevel)
@@ -2102,6 +2366,42 @@ void linkifyText(const TextGeneratorIntf &out,Definition *scope,
 }
 
 
+void linkifyText(const TextGeneratorIntf &out,Definition *scope,
+    FileDef *fileScope,Definition *self,
+    const char *text, bool autoBreak,bool external,
+    bool keepSpaces,int indentLevel)
+{
+  if (!g_resolveCacheEnabled || text==0 || *text==0)
+  {
+    linkifyTextUncached(out,scope,fileScope,self,text,autoBreak,external,
+                        keepSpaces,indentLevel);
+    return;
+  }
+
+  const int maxKeySize = 80;
+  char keyPrefix[maxKeySize];
+  qsnprintf(keyPrefix,maxKeySize,"%p:%p:%p:%d%d%d%d:",scope,fileScope,self,
+            autoBreak,external,keepSpaces,indentLevel);
+  QCString key = keyPrefix;
+  key+=text;
+
+  LinkifiedText *lt = g_linkifyCache.find(key);
+  if (lt==0)
+  {
+    lt = new LinkifiedText;
+    linkifyTextUncached(*lt,scope,fileScope,self,text,autoBreak,external,
+                        keepSpaces,indentLevel);
+    lt->replay(out);
+    if (!g_linkifyCache.insert(key,lt,lt->size()))
+    {
+      delete lt;
+    }
+    return;
+  }
+  lt->replay(out);
+}
+
+
 void writeExample(OutputList &ol,ExampleSDict *ed)
 {
   QCString exampleLine=theTranslator->trWriteList(ed->count());
@@ -3459,7 +3759,7 @@ static QCString getCanonicalTypeForIdentifier(
   return result;
 }
 
-static QCString extractCanonicalType(Definition *d,FileDef *fs,QCString type)
+static QCString extractCanonicalTypeUncached(Definition *d,FileDef *fs,QCString type)
 {
   type = type.stripWhiteSpace();
 
@@ -3529,6 +3829,63 @@ static QCString extractCanonicalType(Definition *d,FileDef *fs,QCString type)
   return removeRedundantWhiteSpace(canType);
 }
 
+// Matching the arguments of overloaded members computes the canonical
+// type of the same argument types in the same scopes over and over again,
+// so the results are cached once the classes and typedefs are known (see
+// setCanonicalTypeCacheEnabled()).
+static QCache<QCString> g_canonicalTypeCache(100000,10007);
+static bool g_canonicalTypeCacheEnabled = FALSE;
+static uint g_canonicalTypeCacheHits;
+static uint g_canonicalTypeCacheMisses;
+
+void initCanonicalTypeCache()
+{
+  g_canonicalTypeCache.setAutoDelete(TRUE);
+}
+
+void setCanonicalTypeCacheEnabled(bool enable)
+{
+  g_canonicalTypeCacheEnabled = enable;
+  if (!enable) g_canonicalTypeCache.clear();
+}
+
+void canonicalTypeCacheStats(uint &count,uint &size,uint &hits,uint &misses)
+{
+  count  = g_canonicalTypeCache.count();
+  size   = g_canonicalTypeCache.maxCost();
+  hits   = g_canonicalTypeCacheHits;
+  misses = g_canonicalTypeCacheMisses;
+}
+
+static QCString extractCanonicalType(Definition *d,FileDef *fs,QCString type)
+{
+  if (!g_canonicalTypeCacheEnabled)
+  {
+    return extractCanonicalTypeUncached(d,fs,type);
+  }
+
+  const int maxAddrSize = 40;
+  char addr[maxAddrSize];
+  qsnprintf(addr,maxAddrSize,"%p:%p:",d,fs);
+  QCString key = addr;
+  key+=type;
+
+  QCString *cachedType = g_canonicalTypeCache.find(key);
+  if (cachedType)
+  {
+    g_canonicalTypeCacheHits++;
+    return *cachedType;
+  }
+  g_canonicalTypeCacheMisses++;
+  QCString result = extractCanonicalTypeUncached(d,fs,type);
+  cachedType = new QCString(result);
+  if (!g_canonicalTypeCache.insert(key,cachedType))
+  {
+    delete cachedType;
+  }
+  return result;
+}
+
 static QCString extractCanonicalArgType(Definition *d,FileDef *fs,const Argument *arg)
 {
   QCString type = arg->type.stripWhiteSpace();
@@ -3877,29 +4234,7 @@ static void findMembersWithSpecificName(MemberName *mn,
   }
 }
 
-/*!
- * Searches for a member definition given its name `memberName' as a string.
- * memberName may also include a (partial) scope to indicate the scope
- * in which the member is located.
- *
- * The parameter `scName' is a string representing the name of the scope in 
- * which the link was found.
- *
- * In case of a function args contains a string representation of the 
- * argument list. Passing 0 means the member has no arguments. 
- * Passing "()" means any argument list will do, but "()" is preferred.
- *
- * The function returns TRUE if the member is known and documented or
- * FALSE if it is not.
- * If TRUE is returned parameter `md' contains a pointer to the member 
- * definition. Furthermore exactly one of the parameter `cd', `nd', or `fd' 
- * will be non-zero:
- *   - if `cd' is non zero, the member was found in a class pointed to by cd.
- *   - if `nd' is non zero, the member was found in a namespace pointed to by nd.
- *   - if `fd' is non zero, the member was found in the global namespace of
- *     file fd.
- */
-bool getDefs(const QCString &scName,
+static bool getDefsUncached(const QCString &scName,
              const QCString &mbName, 
              const char *args,
              MemberDef *&md, 
@@ -4429,6 +4764,73 @@ static bool getScopeDefs(const char *docScope,const char *scope,
   return FALSE;
 }
 
+/*!
+ * Searches for a member definition given its name `memberName' as a string.
+ * memberName may also include a (partial) scope to indicate the scope
+ * in which the member is located.
+ *
+ * The parameter `scName' is a string representing the name of the scope in 
+ * which the link was found.
+ *
+ * In case of a function args contains a string representation of the 
+ * argument list. Passing 0 means the member has no arguments. 
+ * Passing "()" means any argument list will do, but "()" is preferred.
+ *
+ * The function returns TRUE if the member is known and documented or
+ * FALSE if it is not.
+ * If TRUE is returned parameter `md' contains a pointer to the member 
+ * definition. Furthermore exactly one of the parameter `cd', `nd', or `fd' 
+ * will be non-zero:
+ *   - if `cd' is non zero, the member was found in a class pointed to by cd.
+ *   - if `nd' is non zero, the member was found in a namespace pointed to by nd.
+ *   - if `fd' is non zero, the member was found in the global namespace of
+ *     file fd.
+ */
+bool getDefs(const QCString &scName,
+             const QCString &mbName, 
+             const char *args,
+             MemberDef *&md, 
+             ClassDef *&cd, 
+             FileDef *&fd, 
+             NamespaceDef *&nd, 
+             GroupDef *&gd,
+             bool forceEmptyScope,
+             FileDef *currentFile,
+             bool checkCV,
+             const char *forceTagFile
+            )
+{
+  if (!g_resolveCacheEnabled)
+  {
+    return getDefsUncached(scName,mbName,args,md,cd,fd,nd,gd,
+                           forceEmptyScope,currentFile,checkCV,forceTagFile);
+  }
+
+  const int maxKeySize = 40;
+  char keyPrefix[maxKeySize];
+  qsnprintf(keyPrefix,maxKeySize,"D%d%d%p\n",forceEmptyScope,checkCV,currentFile);
+  QCString key = keyPrefix;
+  addKeyPart(key,scName);
+  addKeyPart(key,mbName);
+  addKeyPart(key,args);
+  addKeyPart(key,forceTagFile);
+
+  ResolveCacheElem *elem = findResolveCache(key);
+  if (elem==0)
+  {
+    elem = new ResolveCacheElem;
+    elem->found = getDefsUncached(scName,mbName,args,
+                                  elem->md,elem->cd,elem->fd,elem->nd,elem->gd,
+                                  forceEmptyScope,currentFile,checkCV,forceTagFile);
+    md=elem->md; cd=elem->cd; fd=elem->fd; nd=elem->nd; gd=elem->gd;
+    bool found = elem->found;
+    insertResolveCache(key,elem);
+    return found;
+  }
+  md=elem->md; cd=elem->cd; fd=elem->fd; nd=elem->nd; gd=elem->gd;
+  return elem->found;
+}
+
 static bool isLowerCase(QCString &s)
 {
   uchar *p=(uchar*)s.data();
@@ -4438,10 +4840,7 @@ static bool isLowerCase(QCString &s)
   return TRUE; 
 }
 
-/*! Returns an object to reference to given its name and context 
- *  @post return value TRUE implies *resContext!=0 or *resMember!=0
- */
-bool resolveRef(/* in */  const char *scName,
+static bool resolveRefUncached(/* in */  const char *scName,
     /* in */  const char *name,
     /* in */  bool inSeeBlock,
     /* out */ Definition **resContext,
@@ -4621,6 +5020,50 @@ bool resolveRef(/* in */  const char *scName,
   return FALSE;
 }
 
+/*! Returns an object to reference to given its name and context 
+ *  @post return value TRUE implies *resContext!=0 or *resMember!=0
+ */
+bool resolveRef(/* in */  const char *scName,
+    /* in */  const char *name,
+    /* in */  bool inSeeBlock,
+    /* out */ Definition **resContext,
+    /* out */ MemberDef  **resMember,
+    bool lookForSpecialization,
+    FileDef *currentFile,
+    bool checkScope
+    )
+{
+  if (!g_resolveCacheEnabled)
+  {
+    return resolveRefUncached(scName,name,inSeeBlock,resContext,resMember,
+                              lookForSpecialization,currentFile,checkScope);
+  }
+
+  const int maxKeySize = 40;
+  char keyPrefix[maxKeySize];
+  qsnprintf(keyPrefix,maxKeySize,"R%d%d%d%p\n",
+            inSeeBlock,lookForSpecialization,checkScope,currentFile);
+  QCString key = keyPrefix;
+  addKeyPart(key,scName);
+  addKeyPart(key,name);
+
+  ResolveCacheElem *elem = findResolveCache(key);
+  if (elem==0)
+  {
+    elem = new ResolveCacheElem;
+    elem->found = resolveRefUncached(scName,name,inSeeBlock,&elem->context,&elem->md,
+                                     lookForSpecialization,currentFile,checkScope);
+    *resContext = elem->context;
+    *resMember  = elem->md;
+    bool found  = elem->found;
+    insertResolveCache(key,elem);
+    return found;
+  }
+  *resContext = elem->context;
+  *resMember  = elem->md;
+  return elem->found;
+}
+
 QCString linkToText(SrcLangExt lang,const char *link,bool isFileName)
 {
   //static bool optimizeOutputJava = Config_getBool("OPTIMIZE_OUTPUT_JAVA");
@@ -4915,46 +5358,16 @@ QCString substituteClassNames(const QCString &s)
 
 //----------------------------------------------------------------------
 
-/** Cache element for the file name to FileDef mapping cache. */
-struct FindFileCacheElem
-{
-  FindFileCacheElem(FileDef *fd,bool ambig) : fileDef(fd), isAmbig(ambig) {}
-  FileDef *fileDef;
-  bool isAmbig;
-};
-
-static QCache<FindFileCacheElem> g_findFileDefCache(5000);
-
 FileDef *findFileDef(const FileNameDict *fnDict,const char *n,bool &ambig)
 {
   ambig=FALSE;
   if (n==0) return 0;
 
-  const int maxAddrSize = 20;
-  char addr[maxAddrSize];
-  qsnprintf(addr,maxAddrSize,"%p:",fnDict);
-  QCString key = addr;
-  key+=n;
-
-  g_findFileDefCache.setAutoDelete(TRUE);
-  FindFileCacheElem *cachedResult = g_findFileDefCache.find(key);
-  //printf("key=%s cachedResult=%p\n",key.data(),cachedResult);
-  if (cachedResult)
-  {
-    ambig = cachedResult->isAmbig;
-    //printf("cached: fileDef=%p\n",cachedResult->fileDef);
-    return cachedResult->fileDef;
-  }
-  else
-  {
-    cachedResult = new FindFileCacheElem(0,FALSE);
-  }
-
   QCString name=QDir::cleanDirPath(n).utf8();
   QCString path;
   int slashPos;
   FileName *fn;
-  if (name.isEmpty()) goto exit;
+  if (name.isEmpty()) return 0;
   slashPos=QMAX(name.findRev('/'),name.findRev('\\'));
   if (slashPos!=-1)
   {
@@ -4962,7 +5375,7 @@ FileDef *findFileDef(const FileNameDict *fnDict,const char *n,bool &ambig)
     name=name.right(name.length()-slashPos-1); 
     //printf("path=%s name=%s\n",path.data(),name.data());
   }
-  if (name.isEmpty()) goto exit;
+  if (name.isEmpty()) return 0;
   if ((fn=(*fnDict)[name]))
   {
     //printf("fn->count()=%d\n",fn->count());
@@ -4976,34 +5389,15 @@ FileDef *findFileDef(const FileNameDict *fnDict,const char *n,bool &ambig)
 #endif
       if (path.isEmpty() || isSamePath)
       {
-        cachedResult->fileDef = fd;
-        g_findFileDefCache.insert(key,cachedResult);
-        //printf("=1 ===> add to cache %p\n",fd);
         return fd;
       }
     }
     else // file name alone is ambiguous
     {
       int count=0;
-      FileNameIterator fni(*fn);
-      FileDef *fd;
-      FileDef *lastMatch=0;
-      QCString pathStripped = stripFromIncludePath(path);
-      for (fni.toFirst();(fd=fni.current());++fni)
-      {
-        QCString fdStripPath = stripFromIncludePath(fd->getPath());
-        if (path.isEmpty() || fdStripPath.right(pathStripped.length())==pathStripped) 
-        { 
-          count++; 
-          lastMatch=fd; 
-        }
-      }
-      //printf(">1 ===> add to cache %p\n",fd);
-
+      FileDef *lastMatch = fn->findByPath(
+          path.isEmpty() ? QCString() : stripFromIncludePath(path),count);
       ambig=(count>1);
-      cachedResult->isAmbig = ambig;
-      cachedResult->fileDef = lastMatch;
-      g_findFileDefCache.insert(key,cachedResult);
       return lastMatch;
     }
   }
@@ -5011,10 +5405,6 @@ FileDef *findFileDef(const FileNameDict *fnDict,const char *n,bool &ambig)
   {
     //printf("not found!\n");
   }
-exit:
-  //printf("0  ===> add to cache %p: %s\n",cachedResult,n);
-  g_findFileDefCache.insert(key,cachedResult);
-  //delete cachedResult;
   return 0;
 }
 
@@ -6917,8 +7307,8 @@ MemberDef *getMemberFromSymbol(Definition *scope,FileDef *fileScope,
   if (name.isEmpty())
     return 0; // no name was given
 
-  DefinitionIntf *di = Doxygen::symbolMap->find(name);
-  if (di==0)
+  const SymbolList *sl = Doxygen::symbolMap->find(name);
+  if (sl==0)
     return 0; // could not find any matching symbols
 
   // mostly copied from getResolvedClassRec()
@@ -6935,40 +7325,23 @@ MemberDef *getMemberFromSymbol(Definition *scope,FileDef *fileScope,
   int minDistance = 10000;
   MemberDef *bestMatch = 0;
 
-  if (di->definitionType()==DefinitionIntf::TypeSymbolList)
+  // find the closest closest matching definition
+  uint i;
+  for (i=0;i<sl->count();i++)
   {
-    //printf("multiple matches!\n");
-    // find the closest closest matching definition
-    DefinitionListIterator dli(*(DefinitionList*)di);
-    Definition *d;
-    for (dli.toFirst();(d=dli.current());++dli)
+    Definition *d = sl->at(i);
+    if (d->definitionType()==Definition::TypeMember)
     {
-      if (d->definitionType()==Definition::TypeMember)
+      g_visitedNamespaces.clear();
+      int distance = isAccessibleFromWithExpScope(scope,fileScope,d,explicitScopePart);
+      if (distance!=-1 && distance<minDistance)
       {
-        g_visitedNamespaces.clear();
-        int distance = isAccessibleFromWithExpScope(scope,fileScope,d,explicitScopePart);
-        if (distance!=-1 && distance<minDistance)
-        {
-          minDistance = distance;
-          bestMatch = (MemberDef *)d;
-          //printf("new best match %s distance=%d\n",bestMatch->qualifiedName().data(),distance);
-        }
+        minDistance = distance;
+        bestMatch = (MemberDef *)d;
+        //printf("new best match %s distance=%d\n",bestMatch->qualifiedName().data(),distance);
       }
     }
   }
-  else if (di->definitionType()==Definition::TypeMember)
-  {
-    //printf("unique match!\n");
-    Definition *d = (Definition *)di;
-    g_visitedNamespaces.clear();
-    int distance = isAccessibleFromWithExpScope(scope,fileScope,d,explicitScopePart);
-    if (distance!=-1 && distance<minDistance)
-    {
-      minDistance = distance;
-      bestMatch = (MemberDef *)d;
-      //printf("new best match %s distance=%d\n",bestMatch->qualifiedName().data(),distance);
-    }
-  }
   return bestMatch;
 }
 
@@ -7453,18 +7826,60 @@ void stackTrace()
 #endif
 }
 
-static int transcodeCharacterBuffer(const char *fileName,BufStr &srcBuf,int size,
-           const char *inputEncoding,const char *outputEncoding)
+/** Returns TRUE if the first \a size bytes of \a buf are all 7-bit ASCII. */
+static bool isAsciiBuffer(const char *buf,int size)
+{
+  const uchar *p=(const uchar *)buf, *e=p+size;
+  while (p<e && *p<0x80) p++;
+  return p==e;
+}
+
+/** Returns TRUE if converting 7-bit ASCII text from \a encoding to UTF-8
+ *  leaves it unchanged, which is the case for most single and multibyte
+ *  encodings.
+ */
+static bool isAsciiCompatibleEncoding(const char *encoding)
+{
+  void *cd = portable_iconv_open("UTF-8",encoding);
+  if (cd==(void *)(-1)) return FALSE;
+  char input[128];
+  int len=0,c;
+  input[len++]='\t';
+  input[len++]='\n';
+  input[len++]='\r';
+  for (c=' ';c<0x7f;c++) input[len++]=(char)c;
+  char output[4*sizeof(input)];
+  char *srcPtr = input;
+  char *dstPtr = output;
+  size_t iLeft=len;
+  size_t oLeft=sizeof(output);
+  bool result = !portable_iconv(cd,&srcPtr,&iLeft,&dstPtr,&oLeft) &&
+                sizeof(output)-oLeft==(size_t)len &&
+                memcmp(input,output,len)==0;
+  portable_iconv_close(cd);
+  return result;
+}
+
+static bool transcodeCharacterBuffer(BufStr &srcBuf,int size,
+           const char *inputEncoding,const char *outputEncoding,
+           InputFileStatus &status)
 {
-  if (inputEncoding==0 || outputEncoding==0) return size;
-  if (qstricmp(inputEncoding,outputEncoding)==0) return size;
+  if (inputEncoding==0 || outputEncoding==0) return TRUE;
+  if (qstricmp(inputEncoding,outputEncoding)==0) return TRUE;
+  if (qstricmp(outputEncoding,"UTF-8")==0 && 
+      isAsciiBuffer(srcBuf.data(),size) && 
+      isAsciiCompatibleEncoding(inputEncoding)
+     ) // plain ASCII text is already valid UTF-8, so no need to copy it
+  {
+    return TRUE;
+  }
   void *cd = portable_iconv_open(outputEncoding,inputEncoding);
   if (cd==(void *)(-1)) 
   {
-    err("unsupported character conversion: '%s'->'%s': %s\n"
-        "Check the INPUT_ENCODING setting in the config file!\n",
-        inputEncoding,outputEncoding,strerror(errno));
-    exit(1);
+    status.code = InputFileStatus::UnsupportedEncoding;
+    status.sysError = errno;
+    status.fromEncoding = inputEncoding;
+    return FALSE;
   }
   int tmpBufSize=size*4+1;
   BufStr tmpBuf(tmpBufSize);
@@ -7473,7 +7888,8 @@ static int transcodeCharacterBuffer(const char *fileName,BufStr &srcBuf,int size
   char *srcPtr = srcBuf.data();
   char *dstPtr = tmpBuf.data();
   uint newSize=0;
-  if (!portable_iconv(cd, &srcPtr, &iLeft, &dstPtr, &oLeft))
+  bool ok = !portable_iconv(cd, &srcPtr, &iLeft, &dstPtr, &oLeft);
+  if (ok)
   {
     newSize = tmpBufSize-(int)oLeft;
     srcBuf.shrink(newSize);
@@ -7482,51 +7898,78 @@ static int transcodeCharacterBuffer(const char *fileName,BufStr &srcBuf,int size
   }
   else
   {
-    err("%s: failed to translate characters from %s to %s: check INPUT_ENCODING\n",
-        fileName,inputEncoding,outputEncoding);
-    exit(1);
+    status.code = InputFileStatus::TranscodeFailed;
+    status.fromEncoding = inputEncoding;
   }
   portable_iconv_close(cd);
-  return newSize;
+  return ok;
 }
 
 //! read a file name \a fileName and optionally filter and transcode it
 bool readInputFile(const char *fileName,BufStr &inBuf,bool filter,bool isSourceCode)
+{
+  QCString filterName;
+  if (filter)
+  {
+    filterName = getFileFilter(fileName,isSourceCode);
+  }
+  InputFileStatus status;
+  readInputFileData(fileName,inBuf,filterName,
+                    Config_getString("INPUT_ENCODING"),status);
+  return reportInputFileStatus(fileName,filterName,status,inBuf);
+}
+
+/*! Reads file \a fileName into \a inBuf, passing it through \a filterName
+ *  (if not 0) and transcoding it from \a inputEncoding to UTF-8.
+ *  Problems are stored in \a status rather than reported. Only stdio
+ *  and iconv are used and the configuration is not consulted, so this 
+ *  function can be called from a worker thread, after which the main
+ *  thread should pass \a status to reportInputFileStatus().
+ */
+void readInputFileData(const char *fileName,BufStr &inBuf,
+                       const char *filterName,const char *inputEncoding,
+                       InputFileStatus &status)
 {
   // try to open file
   int size=0;
   //uint oldPos = dest.curPos();
   //printf(".......oldPos=%d\n",oldPos);
 
-  QFileInfo fi(fileName);
-  if (!fi.exists()) return FALSE;
-  QCString filterName = getFileFilter(fileName,isSourceCode);
-  if (filterName.isEmpty() || !filter)
+  status = InputFileStatus();
+  if (filterName==0 || *filterName==0)
   {
-    QFile f(fileName);
-    if (!f.open(IO_ReadOnly))
+    FILE *f=fopen(fileName,"rb");
+    if (!f)
     {
-      err("could not open file %s\n",fileName);
-      return FALSE;
+      status.code = errno==ENOENT ? InputFileStatus::NotFound : 
+                                    InputFileStatus::OpenFailed;
+      return;
     }
-    size=fi.size();
-    // read the file
-    inBuf.skip(size);
-    if (f.readBlock(inBuf.data()/*+oldPos*/,size)!=size)
+    if (fseek(f,0,SEEK_END)==0 && (size=(int)ftell(f))>=0 && 
+        fseek(f,0,SEEK_SET)==0)
     {
-      err("problems while reading file %s\n",fileName);
-      return FALSE;
+      // read the file
+      inBuf.skip(size);
+      if ((int)fread(inBuf.data()/*+oldPos*/,1,size,f)!=size)
+      {
+        status.code = InputFileStatus::ReadFailed;
+      }
+    }
+    else
+    {
+      status.code = InputFileStatus::ReadFailed;
     }
+    fclose(f);
+    if (status.code!=InputFileStatus::Ok) return;
   }
   else
   {
-    QCString cmd=filterName+" \""+fileName+"\"";
-    Debug::print(Debug::ExtCmd,0,"Executing popen(`%s`)\n",qPrint(cmd));
+    QCString cmd=QCString(filterName)+" \""+fileName+"\"";
     FILE *f=portable_popen(cmd,"r");
     if (!f)
     {
-      err("could not execute filter %s\n",filterName.data());
-      return FALSE;
+      status.code = InputFileStatus::FilterFailed;
+      return;
     }
     const int bufSize=1024;
     char buf[bufSize];
@@ -7538,8 +7981,6 @@ bool readInputFile(const char *fileName,BufStr &inBuf,bool filter,bool isSourceC
     }
     portable_pclose(f);
     inBuf.at(inBuf.curPos()) ='\0';
-    Debug::print(Debug::FilterOutput, 0, "Filter output\n");
-    Debug::print(Debug::FilterOutput,0,"-------------\n%s\n-------------\n",qPrint(inBuf));
   }
 
   int start=0;
@@ -7549,8 +7990,8 @@ bool readInputFile(const char *fileName,BufStr &inBuf,bool filter,bool isSourceC
       )
      ) // UCS-2 encoded file
   {
-    transcodeCharacterBuffer(fileName,inBuf,inBuf.curPos(),
-        "UCS-2","UTF-8");
+    if (!transcodeCharacterBuffer(inBuf,inBuf.curPos(),
+          "UCS-2","UTF-8",status)) return;
   }
   else if (size>=3 &&
            (uchar)inBuf.at(0)==0xEF &&
@@ -7563,8 +8004,8 @@ bool readInputFile(const char *fileName,BufStr &inBuf,bool filter,bool isSourceC
   else // transcode according to the INPUT_ENCODING setting
   {
     // do character transcoding if needed.
-    transcodeCharacterBuffer(fileName,inBuf,inBuf.curPos(),
-        Config_getString("INPUT_ENCODING"),"UTF-8");
+    if (!transcodeCharacterBuffer(inBuf,inBuf.curPos(),
+          inputEncoding,"UTF-8",status)) return;
   }
 
   //inBuf.addChar('\n'); /* to prevent problems under Windows ? */
@@ -7579,6 +8020,51 @@ bool readInputFile(const char *fileName,BufStr &inBuf,bool filter,bool isSourceC
     //printf(".......resizing from %d to %d result=[%s]\n",oldPos+size,oldPos+newSize,dest.data());
   }
   inBuf.addChar(0);
+}
+
+/*! Reports the outcome of readInputFileData() for file \a fileName
+ *  that was read into \a inBuf using filter \a filterName. Must be called 
+ *  from the main thread. Exits if the input encoding is not supported.
+ *  Returns TRUE if the file was read successfully.
+ */
+bool reportInputFileStatus(const char *fileName,const char *filterName,
+                           const InputFileStatus &status,const BufStr &inBuf)
+{
+  bool filter = filterName && *filterName;
+  if (filter)
+  {
+    Debug::print(Debug::ExtCmd,0,"Executing popen(`%s \"%s\"`)\n",filterName,fileName);
+  }
+  switch (status.code)
+  {
+    case InputFileStatus::Ok:
+      break;
+    case InputFileStatus::NotFound:
+      return FALSE;
+    case InputFileStatus::OpenFailed:
+      err("could not open file %s\n",fileName);
+      return FALSE;
+    case InputFileStatus::ReadFailed:
+      err("problems while reading file %s\n",fileName);
+      return FALSE;
+    case InputFileStatus::FilterFailed:
+      err("could not execute filter %s\n",filterName);
+      return FALSE;
+    case InputFileStatus::UnsupportedEncoding:
+      err("unsupported character conversion: '%s'->'%s': %s\n"
+          "Check the INPUT_ENCODING setting in the config file!\n",
+          status.fromEncoding,"UTF-8",strerror(status.sysError));
+      exit(1);
+    case InputFileStatus::TranscodeFailed:
+      err("%s: failed to translate characters from %s to %s: check INPUT_ENCODING\n",
+          fileName,status.fromEncoding,"UTF-8");
+      exit(1);
+  }
+  if (filter)
+  {
+    Debug::print(Debug::FilterOutput, 0, "Filter output\n");
+    Debug::print(Debug::FilterOutput,0,"-------------\n%s\n-------------\n",qPrint(inBuf));
+  }
   return TRUE;
 }
 
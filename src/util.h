@@ -353,6 +353,22 @@ int isAccessibleFrom(Definition *scope,FileDef *fileScope,Definition *item);
 int isAccessibleFromWithExpScope(Definition *scope,FileDef *fileScope,Definition *item,
                      const QCString &explicitScopePart);
 
+void setAccessCacheEnabled(bool enable);
+
+void initResolveCache();
+
+void setResolveCacheEnabled(bool enable);
+
+void resolveCacheStats(uint &count,uint &size,uint &hits,uint &misses);
+
+void initCanonicalTypeCache();
+
+void setCanonicalTypeCacheEnabled(bool enable);
+
+void canonicalTypeCacheStats(uint &count,uint &size,uint &hits,uint &misses);
+
+void accessCacheStats(uint &count,uint &hits,uint &misses);
+
 int computeQualifiedIndex(const QCString &name);
 
 void addDirPrefix(QCString &fileName);
@@ -409,6 +425,22 @@ void stackTrace();
 
 bool readInputFile(const char *fileName,BufStr &inBuf,
                    bool filter=TRUE,bool isSourceCode=FALSE);
+
+/** Outcome of reading an input file with readInputFileData(). */
+struct InputFileStatus
+{
+  enum Code { Ok, NotFound, OpenFailed, ReadFailed, FilterFailed,
+              UnsupportedEncoding, TranscodeFailed };
+  InputFileStatus() : code(Ok), sysError(0), fromEncoding(0) {}
+  Code        code;
+  int         sysError;     //!< value of errno for UnsupportedEncoding
+  const char *fromEncoding; //!< encoding that could not be converted
+};
+void readInputFileData(const char *fileName,BufStr &inBuf,
+                       const char *filterName,const char *inputEncoding,
+                       InputFileStatus &status);
+bool reportInputFileStatus(const char *fileName,const char *filterName,
+                           const InputFileStatus &status,const BufStr &inBuf);
 QCString filterTitle(const QCString &title);
 
 bool patternMatch(const QFileInfo &fi,const QStrList *patList);